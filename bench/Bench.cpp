@@ -0,0 +1,866 @@
+// Bench.cpp
+// Benchmarks for the storage, index, loader and ticket paths. Run
+//   tcms_bench <case> [size]
+// from a build made with -DCMAKE_BUILD_TYPE=Release. Cases that need files
+// write them under tcms_bench_data/ in the current directory and reuse them
+// on later runs.
+#include "VersionedStack.h"
+#include "HashIndex.h"
+#include "Match.h"
+#include "MatchHistory.h"
+#include "MatchRecordParser.h"
+#include "MappedFile.h"
+#include "MatchSnapshot.h"
+#include "PlayerNameIndex.h"
+#include "TicketManager.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Count every heap allocation made by the process. Every form of operator
+// new allocates with malloc, and every form of operator delete frees.
+static std::atomic<long long> allocationCount(0);
+
+static void* countedAllocation(std::size_t bytes) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(bytes ? bytes : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t bytes) { return countedAllocation(bytes); }
+void* operator new[](std::size_t bytes) { return countedAllocation(bytes); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Wall time and allocations of one measured step
+class Measurement {
+private:
+    Clock::time_point start;
+    long long startAllocations;
+
+public:
+    Measurement() : start(Clock::now()), startAllocations(allocationCount.load()) {}
+
+    double seconds() const { return std::chrono::duration<double>(Clock::now() - start).count(); }
+    long long allocations() const { return allocationCount.load() - startAllocations; }
+
+    // Print the step's totals and, when ops > 0, its cost per operation
+    void report(const char* label, long long ops = 0) const {
+        double elapsed = seconds();
+        long long allocated = allocations();
+        std::printf("  %-36s %10.1f ms", label, elapsed * 1000);
+        if (ops > 0) {
+            std::printf(" %9.1f ns/op %8.2f allocs/op", elapsed * 1e9 / ops, static_cast<double>(allocated) / ops);
+        }
+        std::printf("\n");
+    }
+};
+
+// Scratch directory for generated files
+std::filesystem::path benchDirectory() {
+    std::filesystem::path dir = std::filesystem::current_path() / "tcms_bench_data";
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+// Write a synthetic match_history.txt of about maxBytes (or maxRows rows,
+// whichever comes first) unless it already exists. IDs run upwards; names
+// come from 255 first/last name pairs. Returns the number of rows.
+long long generateHistory(const std::filesystem::path& path, long long maxBytes, long long maxRows) {
+    static const char* const firstNames[] = { "Roger", "Rafael", "Novak", "Andy", "Carlos", "Jannik", "Daniil", "Casper",
+                                              "Holger", "Taylor", "Frances", "Alex", "Hubert", "Grigor", "Stan" };
+    static const char* const lastNames[] = { "Federer", "Nadal", "Djokovic", "Murray", "Alcaraz", "Sinner",
+                                             "Medvedev", "Ruud", "Rune", "Fritz", "Tiafoe", "Minaur", "Hurkacz",
+                                             "Dimitrov", "Wawrinka", "Zverev", "Thiem" };
+    static const char* const scores[] = { "6-4 6-3", "7-6 6-4", "6-1 6-2", "6-4 3-6 7-5", "7-6(4) 6-7(5) 6-3", "6-3" };
+
+    std::vector<std::string> names;
+    for (const char* first : firstNames) {
+        for (const char* last : lastNames) {
+            names.push_back(std::string(first) + " " + last);
+        }
+    }
+
+    if (std::filesystem::exists(path)) {
+        // Count the rows of the file written by an earlier run
+        MappedFile existing;
+        existing.open(path.string());
+        return countLines(existing.view()) - 1;
+    }
+
+    std::printf("  writing %s...\n", path.filename().string().c_str());
+    std::string tempPath = path.string() + ".tmp";
+    std::FILE* out = std::fopen(tempPath.c_str(), "wb");
+    if (out == nullptr) {
+        std::perror(tempPath.c_str());
+        std::exit(1);
+    }
+
+    std::string buffer = std::string(MATCH_HISTORY_HEADER) + "\n";
+    long long bytes = 0;
+    long long rows = 0;
+    unsigned long long seed = 88172645463325252ULL;
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+
+    while (bytes < maxBytes && rows < maxRows) {
+        const std::string& player1 = names[next() % names.size()];
+        const std::string* player2 = &names[next() % names.size()];
+        if (player2 == &player1) player2 = &names[(player2 - &names[0] + 1) % names.size()];
+        rows++;
+        buffer += std::to_string(rows);
+        buffer += ", ";
+        buffer += player1;
+        buffer += ", ";
+        buffer += *player2;
+        buffer += ", ";
+        buffer += (next() & 1) ? player1 : *player2;
+        buffer += ", ";
+        buffer += scores[next() % 6];
+        buffer += '\n';
+
+        if (buffer.size() >= (1 << 20)) {
+            std::fwrite(buffer.data(), 1, buffer.size(), out);
+            bytes += static_cast<long long>(buffer.size());
+            buffer.clear();
+        }
+    }
+    std::fwrite(buffer.data(), 1, buffer.size(), out);
+    std::fclose(out);
+    std::filesystem::rename(tempPath, path);
+    return rows;
+}
+
+// Player name for a number, the same length as a typical full name
+std::string playerName(int number) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "Player %07d", number);
+    return name;
+}
+
+Match makeMatch(int matchID) {
+    std::string player1 = playerName(matchID % 5000);
+    std::string player2 = playerName((matchID * 7 + 1) % 5000);
+    return Match(matchID, player1, player2, player1, "6-4 3-6 7-6(5)");
+}
+
+// The singly linked Stack the history used before chunked storage: one
+// node per element, values copied in and out, and copies staged through a
+// temporary array.
+template <typename T>
+class LinkedStack {
+private:
+    struct Node {
+        T data;
+        Node* next;
+
+        Node(T value) : data(value), next(nullptr) {}
+    };
+
+    Node* top;
+    int size;
+
+public:
+    LinkedStack() : top(nullptr), size(0) {}
+    ~LinkedStack() { while (top != nullptr) pop(); }
+
+    LinkedStack(const LinkedStack<T>& other) : top(nullptr), size(0) {
+        T* elements = new T[other.size];
+        int count = 0;
+        for (Node* current = other.top; current != nullptr; current = current->next) {
+            elements[other.size - 1 - count] = current->data;
+            count++;
+        }
+        for (int i = 0; i < other.size; i++) {
+            push(elements[i]);
+        }
+        delete[] elements;
+    }
+
+    void push(const T& value) {
+        Node* node = new Node(value);
+        node->next = top;
+        top = node;
+        size++;
+    }
+
+    T pop() {
+        Node* node = top;
+        T value = node->data;
+        top = node->next;
+        delete node;
+        size--;
+        return value;
+    }
+
+    bool isEmpty() const { return top == nullptr; }
+};
+
+// user-001: push, copy and pop 10^6 matches with the chunked stack the
+// history keeps them in (VersionedStack, which took over Stack.h), against
+// the linked stack it replaced
+void benchStack(int count) {
+    std::printf("stack: %d matches\n", count);
+
+    long long checksum = 0;
+    {
+        // Cost of building the matches, included in both push rows
+        Measurement build;
+        for (int i = 1; i <= count; i++) {
+            checksum += makeMatch(i).matchID;
+        }
+        build.report("build matches only", count);
+    }
+
+    {
+        LinkedStack<Match> linked;
+        Measurement push;
+        for (int i = 1; i <= count; i++) {
+            linked.push(makeMatch(i));
+        }
+        push.report("linked push (copy)", count);
+
+        Measurement copy;
+        LinkedStack<Match> duplicate(linked);
+        copy.report("linked copy (temporary array)", count);
+
+        Measurement pop;
+        while (!linked.isEmpty()) {
+            checksum += linked.pop().matchID;
+        }
+        pop.report("linked pop (copy)", count);
+    }
+
+    {
+        VersionedStack<Match> stack;
+        Measurement push;
+        for (int i = 1; i <= count; i++) {
+            stack.push(makeMatch(i));
+        }
+        push.report("chunked push (move)", count);
+
+        Measurement copy;
+        VersionedStack<Match> duplicate(stack);
+        copy.report("chunked copy", count);
+
+        Measurement pop;
+        while (!stack.isEmpty()) {
+            checksum += stack.pop().matchID;
+        }
+        pop.report("chunked pop (move)", count);
+
+        // Refill the emptied chunks in place
+        Measurement emplace;
+        for (int i = 1; i <= count; i++) {
+            stack.emplace(i, playerName(i % 5000), playerName((i * 7 + 1) % 5000), playerName(i % 5000), "6-4");
+        }
+        emplace.report("chunked emplace into reused chunks", count);
+
+        // Popping what a snapshot can still see copies instead of moving
+        stack.publish();
+        Measurement publishedPop;
+        while (!stack.isEmpty()) {
+            checksum += stack.pop().matchID;
+        }
+        publishedPop.report("chunked pop after publish (copy)", count);
+
+        Measurement walk;
+        for (const Match& match : duplicate) {
+            checksum += match.matchID;
+        }
+        walk.report("walk top to bottom", count);
+    }
+
+    std::printf("  (checksum %lld)\n", checksum);
+}
+
+// user-003: 1M inserts into the match ID index on its own and through the
+// history, then lookups, against a linear scan of the stored matches
+void benchHashIndex(int count) {
+    std::printf("hash: %d matches\n", count);
+
+    long long checksum = 0;
+    {
+        HashIndex<int> index;
+        Measurement insert;
+        for (int i = 1; i <= count; i++) {
+            index.insert(i * 13, i);
+        }
+        insert.report("HashIndex insert", count);
+
+        Measurement find;
+        for (int i = 1; i <= count; i++) {
+            checksum += index.find(i * 13);
+        }
+        find.report("HashIndex find (hit)", count);
+
+        Measurement miss;
+        for (int i = 1; i <= count; i++) {
+            checksum += index.find(i * 13 + 1);
+        }
+        miss.report("HashIndex find (miss)", count);
+    }
+
+    MatchHistory history;
+    std::vector<Match> batch;
+    batch.reserve(count);
+    for (int i = 1; i <= count; i++) {
+        batch.push_back(makeMatch(i));
+    }
+
+    // Every index the history keeps (IDs, names, stats, scores) is updated
+    Measurement add;
+    ImportReport report = history.addMatches(std::move(batch), ConflictPolicy::Skip);
+    add.report("MatchHistory addMatches (all indexes)", count);
+
+    // A second batch where every match collides with a stored ID
+    std::vector<Match> conflicts;
+    for (int i = 1; i <= count; i += 100) {
+        conflicts.push_back(makeMatch(i));
+    }
+    int conflictCount = static_cast<int>(conflicts.size());
+    Measurement replace;
+    history.addMatches(std::move(conflicts), ConflictPolicy::Replace);
+    replace.report("addMatches replacing existing IDs", conflictCount);
+
+    Measurement lookup;
+    for (int i = 1; i <= count; i++) {
+        checksum += history.findMatchByID(i)->matchID;
+    }
+    lookup.report("findMatchByID", count);
+
+    // What every lookup cost before the index: a walk over the stored matches
+    MatchHistorySnapshot matches = history.snapshot();
+    const int scans = 200;
+    Measurement scan;
+    for (int i = 0; i < scans; i++) {
+        int wanted = 1 + (i * 4999) % count;
+        const Match* found = matches.find_if([wanted](const Match& match) { return match.matchID == wanted; });
+        checksum += found->matchID;
+    }
+    scan.report("linear scan by ID", scans);
+
+    std::printf("  (added %d, checksum %lld)\n", report.added, checksum);
+}
+
+// The match_history.txt row loop the history used before the mapped
+// loader: getline, a stringstream per row, substr per field and exceptions
+// for bad rows. Returns the number of valid rows.
+long long loadWithStreams(const std::string& path, long long& checksum) {
+    std::ifstream inFile(path);
+    std::string line;
+    std::getline(inFile, line); // Header
+
+    long long loaded = 0;
+    while (std::getline(inFile, line)) {
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        std::string token;
+        try {
+            if (!std::getline(ss, token, ',')) throw std::runtime_error("Failed to parse Match ID.");
+            int matchID = std::stoi(token);
+            if (!std::getline(ss, token, ',')) throw std::runtime_error("Failed to parse Player 1 name.");
+            std::string player1 = token.substr(token[0] == ' ' ? 1 : 0);
+            if (!std::getline(ss, token, ',')) throw std::runtime_error("Failed to parse Player 2 name.");
+            std::string player2 = token.substr(token[0] == ' ' ? 1 : 0);
+            if (!std::getline(ss, token, ',')) throw std::runtime_error("Failed to parse Winner name.");
+            std::string winner = token.substr(token[0] == ' ' ? 1 : 0);
+            if (!std::getline(ss, token)) throw std::runtime_error("Failed to parse Score.");
+            std::string score = token.substr(token[0] == ' ' ? 1 : 0);
+            if (winner != player1 && winner != player2) throw std::runtime_error("Winner must be one of the players.");
+
+            Match match(matchID, player1, player2, winner, score);
+            checksum += match.matchID;
+            loaded++;
+        } catch (const std::exception&) {
+            // Bad row, skipped
+        }
+    }
+    return loaded;
+}
+
+// Parse every row of a mapped history file with the string_view parser
+long long loadWithParser(const std::string& path, long long& checksum, size_t& errorCount) {
+    MappedFile file;
+    file.open(path);
+    std::string_view text = file.view();
+    takeLine(text); // Header
+
+    long long loaded = 0;
+    std::vector<ParseError> errors;
+    parseMatchRecords(text, 2, [&](const MatchRecordView& record, int) {
+        checksum += record.matchID;
+        loaded++;
+    }, errors);
+    errorCount = errors.size();
+    return loaded;
+}
+
+// user-005: parse a 1 GB history with the old stream loop and with the
+// mapped string_view parser, then load a smaller file all the way into
+// MatchHistory
+void benchLoad(long long megabytes) {
+    std::printf("load: %lld MB\n", megabytes);
+    std::filesystem::path path = benchDirectory() / ("history_" + std::to_string(megabytes) + "mb.txt");
+    long long rows = generateHistory(path, megabytes << 20, 1LL << 40);
+    double bytes = static_cast<double>(std::filesystem::file_size(path));
+
+    // Read once so both parsers start from the page cache
+    long long checksum = 0;
+    size_t errorCount = 0;
+    loadWithParser(path.string(), checksum, errorCount);
+
+    checksum = 0;
+    Measurement streams;
+    long long streamRows = loadWithStreams(path.string(), checksum);
+    double streamSeconds = streams.seconds();
+    streams.report("getline + stringstream rows", streamRows);
+    std::printf("  %-36s %10.0f MB/s\n", "", bytes / (1 << 20) / streamSeconds);
+
+    long long parserChecksum = 0;
+    Measurement parser;
+    long long parserRows = loadWithParser(path.string(), parserChecksum, errorCount);
+    double parserSeconds = parser.seconds();
+    parser.report("mmap + string_view rows", parserRows);
+    std::printf("  %-36s %10.0f MB/s\n", "", bytes / (1 << 20) / parserSeconds);
+
+    if (streamRows != rows || parserRows != rows || checksum != parserChecksum || errorCount != 0) {
+        std::printf("  MISMATCH: %lld rows written, %lld / %lld parsed\n", rows, streamRows, parserRows);
+    }
+
+    // Each Match costs about 140 bytes plus its index entries, so only a
+    // smaller file is loaded into the history itself
+    long long fullMegabytes = megabytes < 256 ? megabytes : 256;
+    std::filesystem::path fullPath = benchDirectory() / ("history_" + std::to_string(fullMegabytes) + "mb.txt");
+    long long fullRows = generateHistory(fullPath, fullMegabytes << 20, 1LL << 40);
+    {
+        MatchHistory history;
+        Measurement load;
+        history.loadFromFile(fullPath.string());
+        load.report("MatchHistory::loadFromFile", fullRows);
+        std::printf("  %-36s %10lld MB, %d matches\n", "", fullMegabytes, history.getTotalMatches());
+    }
+}
+
+// user-008: the history parser and a full load at 1, 2, 4 ... threads, up
+// to twice the hardware thread count (at least 4)
+void benchThreads(long long megabytes) {
+    int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    int maxThreads = hardwareThreads * 2 > 4 ? hardwareThreads * 2 : 4;
+    std::printf("threads: %lld MB, %d hardware threads\n", megabytes, hardwareThreads);
+
+    std::filesystem::path path = benchDirectory() / ("history_" + std::to_string(megabytes) + "mb.txt");
+    long long rows = generateHistory(path, megabytes << 20, 1LL << 40);
+
+    // Unmapped again before the loads below, which need the memory
+    {
+        MappedFile file;
+        file.open(path.string());
+        std::string_view text = file.view();
+        takeLine(text); // Header
+
+        double baseline = 0;
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            Measurement parse;
+            std::vector<long long> counts = parseInParallel<long long>(text, threads, [](std::string_view chunk, long long& count) {
+                std::vector<ParseError> errors;
+                count = 0;
+                parseMatchRecords(chunk, 0, [&count](const MatchRecordView&, int) { count++; }, errors);
+            });
+            double seconds = parse.seconds();
+            long long parsed = 0;
+            for (long long count : counts) parsed += count;
+            if (threads == 1) baseline = seconds;
+
+            std::string label = "parse, " + std::to_string(threads) + " thread(s)";
+            parse.report(label.c_str(), parsed);
+            std::printf("  %-36s %10.2fx %s\n", "", baseline / seconds, parsed == rows ? "" : "MISMATCH");
+        }
+    }
+
+    // The whole load, with the thread count the loader would pick overridden
+    long long fullMegabytes = megabytes < 256 ? megabytes : 256;
+    std::filesystem::path fullPath = benchDirectory() / ("history_" + std::to_string(fullMegabytes) + "mb.txt");
+    long long fullRows = generateHistory(fullPath, fullMegabytes << 20, 1LL << 40);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        setenv("TCMS_PARSE_THREADS", std::to_string(threads).c_str(), 1);
+        MatchHistory history;
+        Measurement load;
+        history.loadFromFile(fullPath.string());
+        std::string label = "loadFromFile " + std::to_string(fullMegabytes) + " MB, " + std::to_string(threads) + " thread(s)";
+        load.report(label.c_str(), fullRows);
+    }
+    unsetenv("TCMS_PARSE_THREADS");
+}
+
+// user-015: one thread recording matches while N threads read snapshots of
+// the history. Each reader operation takes a snapshot and reads its ten
+// latest matches; each writer operation adds one match.
+void benchReaders(int maxReaders) {
+    const int preloaded = 100000;
+    const double secondsPerRun = 1.0;
+    std::printf("readers: 1 writer, up to %d readers, %d matches preloaded, %d hardware threads\n", maxReaders,
+                preloaded, static_cast<int>(std::thread::hardware_concurrency()));
+
+    for (int readers = 0; readers <= maxReaders; readers = readers == 0 ? 1 : readers * 2) {
+        MatchHistory history;
+        std::vector<Match> batch;
+        for (int i = 1; i <= preloaded; i++) {
+            batch.push_back(makeMatch(i));
+        }
+        history.addMatches(std::move(batch), ConflictPolicy::Skip);
+
+        std::atomic<bool> stop(false);
+        std::atomic<long long> reads(0);
+        std::atomic<long long> torn(0);
+        std::vector<std::thread> threads;
+        for (int r = 0; r < readers; r++) {
+            threads.emplace_back([&history, &stop, &reads, &torn]() {
+                long long done = 0;
+                long long bad = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    MatchHistorySnapshot matches = history.snapshot();
+                    // IDs were added in order, so the latest match carries the size as its ID
+                    int expected = matches.getSize();
+                    for (const Match& match : matches.topN(10)) {
+                        if (match.matchID != expected--) bad++;
+                    }
+                    done++;
+                }
+                reads += done;
+                torn += bad;
+            });
+        }
+
+        long long writes = 0;
+        Measurement run;
+        while (run.seconds() < secondsPerRun) {
+            std::vector<Match> one;
+            one.push_back(makeMatch(preloaded + static_cast<int>(++writes)));
+            history.addMatches(std::move(one), ConflictPolicy::Skip);
+        }
+        double elapsed = run.seconds();
+        stop = true;
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::string label = "1 writer, " + std::to_string(readers) + " reader(s)";
+        std::printf("  %-36s %10.0f writes/s %12.0f reads/s %s\n", label.c_str(), writes / elapsed,
+                    reads.load() / elapsed, torn.load() == 0 ? "" : "TORN READS");
+    }
+}
+
+// Drop a file's pages from the page cache so the next read comes from disk
+void evictFromPageCache(const std::filesystem::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+// user-007: start-up from a binary snapshot of a 10M-match history, with
+// the snapshot evicted from the page cache first
+void benchSnapshot(long long count) {
+    std::printf("snapshot: %lld matches\n", count);
+    std::filesystem::path path = benchDirectory() / ("history_" + std::to_string(count) + "rows.txt");
+    long long rows = generateHistory(path, 1LL << 40, count);
+    std::string snapshotPath = snapshotPathFor(path.string());
+
+    if (!isSnapshotCurrent(path.string())) {
+        Measurement convert;
+        if (!convertCsvToSnapshot(path.string(), snapshotPath)) {
+            std::printf("  could not write %s\n", snapshotPath.c_str());
+            return;
+        }
+        convert.report("convert text to snapshot", rows);
+    }
+    std::printf("  %-36s %10.1f MB text, %.1f MB snapshot\n", "", std::filesystem::file_size(path) / 1048576.0,
+                std::filesystem::file_size(snapshotPath) / 1048576.0);
+
+    // Map the snapshot and touch every field of every match, as a reader
+    // working straight off the file would
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 0) evictFromPageCache(snapshotPath);
+        Measurement scan;
+        MatchSnapshotReader reader;
+        std::string error;
+        if (!reader.open(snapshotPath, error)) {
+            std::printf("  %s\n", error.c_str());
+            return;
+        }
+        long long checksum = 0;
+        for (int i = 0; i < reader.getMatchCount(); i++) {
+            checksum += reader.matchID(i) + reader.player1(i).size() + reader.player2(i).size() +
+                        reader.winner(i).size() + reader.score(i).size();
+        }
+        scan.report(pass == 0 ? "open + scan snapshot (cold cache)" : "open + scan snapshot (warm cache)",
+                    reader.getMatchCount());
+        std::printf("  %-36s %10s (checksum %lld)\n", "", "", checksum);
+    }
+
+    // The start-up TCMS actually does: every match copied into the history
+    // and indexed
+    evictFromPageCache(snapshotPath);
+    {
+        MatchHistory history;
+        Measurement load;
+        history.loadFromFile(path.string());
+        load.report("loadFromFile via snapshot (cold)", history.getTotalMatches());
+    }
+}
+
+// user-019: fuzzy name search over tens of thousands of distinct names,
+// with whole-name typos and misspelled surnames as queries
+void benchFuzzy(int nameCount) {
+    std::printf("fuzzy: %d distinct names\n", nameCount);
+
+    // Pronounceable names from syllables, e.g. "Tavoreni Kastelu"
+    static const char* const syllables[] = { "ka", "to", "ren", "vi", "mar", "lu", "sen", "do", "ri", "an",
+                                             "bel", "cho", "fa", "gu", "ni", "os", "pe", "qui", "sa", "tel",
+                                             "u", "va", "wen", "xi", "yo", "zar" };
+    unsigned long long seed = 2463534242ULL;
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    auto word = [&](int syllableCount) {
+        std::string text;
+        for (int i = 0; i < syllableCount; i++) text += syllables[next() % 26];
+        text[0] = static_cast<char>(text[0] - 'a' + 'A');
+        return text;
+    };
+
+    PlayerNameIndex index;
+    std::vector<std::string> names;
+    Measurement build;
+    while (index.getNameCount() < nameCount) {
+        std::string name = word(2 + next() % 2) + " " + word(2 + next() % 3);
+        int before = index.getNameCount();
+        index.addMatch(static_cast<int>(names.size()), Match(static_cast<int>(names.size()) + 1, name, name + " Jr", name, "6-4"));
+        if (index.getNameCount() > before) names.push_back(name);
+    }
+    build.report("index names", index.getNameCount());
+
+    // Queries: a name with one letter changed, and a surname with two
+    const int queries = 2000;
+    std::vector<std::string> wholeNames;
+    std::vector<std::string> surnames;
+    for (int i = 0; i < queries; i++) {
+        std::string name = names[next() % names.size()];
+        name[1 + next() % (name.size() - 1)] = 'k';
+        wholeNames.push_back(name);
+
+        std::string surname = names[next() % names.size()];
+        surname = surname.substr(surname.find(' ') + 1);
+        surname[next() % surname.size()] = 'q';
+        surname.insert(surname.begin() + next() % surname.size(), 'h');
+        surnames.push_back(surname);
+    }
+
+    std::vector<NameCandidate> found;
+    long long candidates = 0;
+    for (int maxDistance = 1; maxDistance <= 2; maxDistance++) {
+        Measurement whole;
+        for (const std::string& query : wholeNames) {
+            index.findSimilarNames(query, maxDistance, found);
+            candidates += static_cast<long long>(found.size());
+        }
+        std::string label = "whole-name typo, k=" + std::to_string(maxDistance);
+        whole.report(label.c_str(), queries);
+
+        Measurement surname;
+        for (const std::string& query : surnames) {
+            index.findSimilarNames(query, maxDistance, found);
+            candidates += static_cast<long long>(found.size());
+        }
+        label = "misspelled surname, k=" + std::to_string(maxDistance);
+        surname.report(label.c_str(), queries);
+    }
+    std::printf("  (%lld candidates)\n", candidates);
+}
+
+// Discard std::cout for as long as it lives (ticket saves report progress);
+// the measurements print through stdio and still show
+class SilenceOutput {
+private:
+    std::ostringstream sink;
+    std::streambuf* previous;
+
+public:
+    SilenceOutput() : previous(std::cout.rdbuf(sink.rdbuf())) {}
+    ~SilenceOutput() { std::cout.rdbuf(previous); }
+};
+
+// The gate loop TicketQueue had before batch admission: scan from the
+// first ticket for a Pending one, confirm it, rewrite the whole file
+void admitOneAndRewrite(std::vector<Ticket>& tickets, const std::string& path) {
+    for (Ticket& ticket : tickets) {
+        if (ticket.status == "Pending") {
+            ticket.status = "Confirmed";
+            break;
+        }
+    }
+    std::ofstream file(path);
+    file << "TicketID,BuyerName,Type,Status\n";
+    for (const Ticket& ticket : tickets) {
+        file << ticket.ticketID << "," << ticket.buyerName << "," << ticket.type << "," << ticket.status << "\n";
+    }
+}
+
+// user-025: sell and admit 50k spectators through the gate operations,
+// against a sample of the old one-ticket scan-and-rewrite loop
+void benchGate(int count) {
+    std::printf("gate: %d tickets\n", count);
+
+    // TicketQueue works on data/ relative to the current directory
+    std::filesystem::path previousDirectory = std::filesystem::current_path();
+    std::filesystem::path dir = benchDirectory() / "gate";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir / "data");
+    std::filesystem::current_path(dir);
+    std::ofstream(TICKET_SALES_FILE) << "TicketID,BuyerName,Type,Status\n";
+
+    SilenceOutput quiet;
+    std::vector<Ticket> sold;
+    {
+        TicketQueue queue;
+        queue.loadFromFile();
+
+        // One journal record and sync per sale, compacted every 1000 records
+        Measurement sell;
+        for (int i = 0; i < count; i++) {
+            Ticket ticket;
+            ticket.ticketID = queue.generateTicketID();
+            ticket.buyerName = "Spectator " + std::to_string(i);
+            ticket.type = i % 5 == 0 ? "VIP" : "Regular";
+            ticket.status = "Pending";
+            queue.addTicket(ticket);
+            sold.push_back(ticket);
+        }
+        sell.report("sell (addTicket)", count);
+
+        std::vector<const Ticket*> admitted;
+        int admittedTotal = 0;
+        const int singles = count / 50;
+        Measurement single;
+        for (int i = 0; i < singles; i++) {
+            queue.admitNext(1, admitted);
+            admittedTotal += static_cast<int>(admitted.size());
+        }
+        single.report("admitNext(1)", singles);
+
+        const int batches = 20;
+        Measurement batch;
+        for (int i = 0; i < batches; i++) {
+            queue.admitNext(500, admitted);
+            admittedTotal += static_cast<int>(admitted.size());
+        }
+        batch.report("admitNext(500)", batches);
+
+        Measurement all;
+        queue.admitAll(admitted);
+        int rest = static_cast<int>(admitted.size());
+        admittedTotal += rest;
+        all.report("admitAll (rest of the queue)", rest);
+
+        Measurement save;
+        queue.saveToFile();
+        save.report("saveToFile");
+
+        std::printf("  %-36s %10d admitted, %d pending\n", "", admittedTotal,
+                    queue.getStatusCount(TicketStatus::Pending));
+    }
+
+    {
+        TicketQueue queue;
+        Measurement load;
+        queue.loadFromFile();
+        load.report("loadFromFile", queue.getSize());
+    }
+
+    // The old loop rewrote the file for every ticket; a sample is enough
+    const int sample = count / 100;
+    Measurement old;
+    for (int i = 0; i < sample; i++) {
+        admitOneAndRewrite(sold, TICKET_SALES_FILE);
+    }
+    double oldSeconds = old.seconds();
+    old.report("old scan + rewrite per ticket", sample);
+    std::printf("  %-36s %10.1f s for all %d (extrapolated)\n", "", oldSeconds / sample * count, count);
+
+    std::filesystem::current_path(previousDirectory);
+}
+
+void usage() {
+    std::cout << "Usage: tcms_bench <case> [size]\n"
+              << "  stack [matches=1000000]    chunked stack against the old linked stack\n"
+              << "  hash [matches=1000000]     match ID index inserts and lookups\n"
+              << "  load [megabytes=1024]      old and mapped history parsers on a synthetic file\n"
+              << "  threads [megabytes=1024]   parser and loader scaling from 1 to N threads\n"
+              << "  readers [threads=8]        1 writer with 0 to N snapshot readers\n"
+              << "  snapshot [matches=10000000] cold start from a binary snapshot\n"
+              << "  fuzzy [names=50000]        fuzzy player search over distinct names\n"
+              << "  gate [tickets=50000]       selling and admitting spectators\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        usage();
+        return 1;
+    }
+
+    std::string name = argv[1];
+    long long size = argc > 2 ? std::atoll(argv[2]) : 0;
+
+    if (name == "stack") {
+        benchStack(size > 0 ? static_cast<int>(size) : 1000000);
+    } else if (name == "hash") {
+        benchHashIndex(size > 0 ? static_cast<int>(size) : 1000000);
+    } else if (name == "load") {
+        benchLoad(size > 0 ? size : 1024);
+    } else if (name == "threads") {
+        benchThreads(size > 0 ? size : 1024);
+    } else if (name == "readers") {
+        benchReaders(size > 0 ? static_cast<int>(size) : 8);
+    } else if (name == "snapshot") {
+        benchSnapshot(size > 0 ? size : 10000000);
+    } else if (name == "fuzzy") {
+        benchFuzzy(size > 0 ? static_cast<int>(size) : 50000);
+    } else if (name == "gate") {
+        benchGate(size > 0 ? static_cast<int>(size) : 50000);
+    } else {
+        usage();
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,38 @@
+// FuzzyMatch.h
+#ifndef FUZZY_MATCH_H
+#define FUZZY_MATCH_H
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <climits>
+
+// Case-insensitive (ASCII) Levenshtein distance from one pattern to many
+// texts, using Myers' bit-parallel algorithm: each text character updates
+// a whole 64-row column of the edit distance matrix with a handful of
+// word operations, so comparing against a name costs O(length) rather than
+// O(length^2). Patterns longer than 64 characters use several words per
+// column (Hyyro's blocked variant); there is no length limit.
+class FuzzyPattern {
+private:
+    std::vector<uint64_t> peq;  // [character * blocks + block] -> rows holding that character
+    int length;
+    int blocks;
+
+public:
+    // Prepare a pattern for matching
+    explicit FuzzyPattern(std::string_view pattern);
+
+    // Length of the pattern
+    int getLength() const { return length; }
+
+    // Edit distance from the pattern to text. Once the distance is certain
+    // to exceed maxDistance the comparison stops and maxDistance + 1 is
+    // returned.
+    int distance(std::string_view text, int maxDistance = INT_MAX - 1) const;
+};
+
+// Edit distance between two strings, ignoring ASCII case
+int editDistance(std::string_view a, std::string_view b);
+
+#endif // FUZZY_MATCH_H
@@ -0,0 +1,197 @@
+// HashIndex.h
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <stdexcept>
+#include <new>
+#include <cstdint>
+
+// Open-addressing hash index from an integer key to a non-negative int
+// value (typically a position in another container). Uses linear probing
+// over a power-of-two table and grows once it is 70% full.
+template <typename Key>
+class HashIndex {
+private:
+    struct Slot {
+        Key key;
+        int value;  // -1 marks an empty slot
+    };
+
+    Slot* slots;
+    int capacity;  // Always zero or a power of two
+    int size;
+
+    // Spread sequential keys across the table
+    static uint64_t hashKey(Key key);
+
+    // Slot holding key, or the empty slot where it would be inserted
+    int probe(Key key) const;
+
+    void grow();
+
+public:
+    // Constructor
+    HashIndex() : slots(nullptr), capacity(0), size(0) {}
+
+    // Copy constructor
+    HashIndex(const HashIndex<Key>& other);
+
+    // Assignment operator
+    HashIndex<Key>& operator=(const HashIndex<Key>& other);
+
+    // Destructor
+    ~HashIndex();
+
+    // Value stored for key, or -1 if absent
+    int find(Key key) const;
+
+    // Check whether key is present
+    bool contains(Key key) const;
+
+    // Insert key, or overwrite its value if already present
+    void insert(Key key, int value);
+
+    // Make room for at least count keys without rehashing
+    void reserve(int count);
+
+    // Remove every key
+    void clear();
+
+    // Number of keys stored
+    int getSize() const;
+};
+
+template <typename Key>
+HashIndex<Key>::HashIndex(const HashIndex<Key>& other) : slots(nullptr), capacity(other.capacity), size(other.size) {
+    if (capacity > 0) {
+        slots = new Slot[capacity];
+        for (int i = 0; i < capacity; i++) {
+            slots[i] = other.slots[i];
+        }
+    }
+}
+
+template <typename Key>
+HashIndex<Key>& HashIndex<Key>::operator=(const HashIndex<Key>& other) {
+    if (this == &other) {
+        return *this; // Self-assignment check
+    }
+
+    HashIndex<Key> copy(other);
+    Slot* oldSlots = slots;
+    slots = copy.slots;
+    capacity = copy.capacity;
+    size = copy.size;
+    copy.slots = oldSlots;
+    return *this;
+}
+
+template <typename Key>
+HashIndex<Key>::~HashIndex() {
+    delete[] slots;
+}
+
+template <typename Key>
+uint64_t HashIndex<Key>::hashKey(Key key) {
+    // splitmix64 finaliser
+    uint64_t x = static_cast<uint64_t>(key);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+template <typename Key>
+int HashIndex<Key>::probe(Key key) const {
+    int mask = capacity - 1;
+    int i = static_cast<int>(hashKey(key) & static_cast<uint64_t>(mask));
+    while (slots[i].value >= 0 && slots[i].key != key) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+template <typename Key>
+void HashIndex<Key>::grow() {
+    reserve(capacity == 0 ? 8 : capacity);
+}
+
+template <typename Key>
+void HashIndex<Key>::reserve(int count) {
+    // Keep the load factor at or below 0.7
+    int needed = 8;
+    while (needed * 7 < (count + 1) * 10) {
+        needed *= 2;
+    }
+    if (needed <= capacity) {
+        return;
+    }
+
+    Slot* oldSlots = slots;
+    int oldCapacity = capacity;
+
+    try {
+        slots = new Slot[needed];
+    } catch (const std::bad_alloc&) {
+        slots = oldSlots;
+        throw std::runtime_error("Memory allocation failed when growing hash index.");
+    }
+    capacity = needed;
+    for (int i = 0; i < capacity; i++) {
+        slots[i].value = -1;
+    }
+
+    for (int i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].value >= 0) {
+            slots[probe(oldSlots[i].key)] = oldSlots[i];
+        }
+    }
+    delete[] oldSlots;
+}
+
+template <typename Key>
+int HashIndex<Key>::find(Key key) const {
+    if (size == 0) {
+        return -1;
+    }
+    return slots[probe(key)].value;
+}
+
+template <typename Key>
+bool HashIndex<Key>::contains(Key key) const {
+    return find(key) >= 0;
+}
+
+template <typename Key>
+void HashIndex<Key>::insert(Key key, int value) {
+    if (value < 0) {
+        throw std::runtime_error("Hash index values must be non-negative.");
+    }
+    if ((size + 1) * 10 > capacity * 7) {
+        grow();
+    }
+
+    int i = probe(key);
+    if (slots[i].value < 0) {
+        slots[i].key = key;
+        size++;
+    }
+    slots[i].value = value;
+}
+
+template <typename Key>
+void HashIndex<Key>::clear() {
+    for (int i = 0; i < capacity; i++) {
+        slots[i].value = -1;
+    }
+    size = 0;
+}
+
+template <typename Key>
+int HashIndex<Key>::getSize() const {
+    return size;
+}
+
+#endif // HASH_INDEX_H
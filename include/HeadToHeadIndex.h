@@ -0,0 +1,65 @@
+// HeadToHeadIndex.h
+#ifndef HEAD_TO_HEAD_INDEX_H
+#define HEAD_TO_HEAD_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include "HashIndex.h"
+
+// Meetings between one pair of players. The pair is stored with the lower
+// name ID first regardless of who was player 1 in each match.
+struct HeadToHeadRecord {
+    int lowID;                 // Smaller name ID of the pair
+    int highID;                // Larger name ID of the pair
+    int lowWins;               // Matches won by lowID
+    int highWins;              // Matches won by highID
+    std::vector<int> positions; // Stack positions of their matches (ascending)
+
+    // Number of matches the pair has played
+    int getMeetings() const;
+
+    // Stack position of their most recent match, or -1 if none remain
+    int getLastMeeting() const;
+
+    // Wins of one player of the pair over the other
+    int getWins(int nameID) const;
+};
+
+// Head-to-head records keyed by an unordered pair of PlayerNameIndex name
+// IDs. The pair lookup is a single hash probe. Each player also keeps the
+// list of pairs they appear in, so their rivals can be listed without
+// scanning the history. Storage is one position per match plus one record
+// per distinct pairing.
+class HeadToHeadIndex {
+private:
+    HashIndex<uint64_t> pairSlots;          // packed pair -> index into records
+    std::vector<HeadToHeadRecord> records;
+    std::vector<std::vector<int>> rivalries; // name ID -> indices into records
+
+    static uint64_t packPair(int lowID, int highID);
+
+    // Record for a pair, creating it if needed
+    HeadToHeadRecord& entry(int lowID, int highID);
+
+public:
+    // Record a match stored at position. winnerSide is 1 or 2 for the
+    // winning player, or 0 if the winner is neither player.
+    void addMatch(int position, int player1ID, int player2ID, int winnerSide);
+
+    // Make room for count more matches between two players
+    void reserveMatches(int player1ID, int player2ID, int count);
+
+    // Forget a match previously recorded at position
+    void removeMatch(int position, int player1ID, int player2ID, int winnerSide);
+
+    // Record of two players, or nullptr if they have never met
+    const HeadToHeadRecord* find(int playerA, int playerB) const;
+
+    // Records of every pairing a player appears in
+    void findRivalries(int nameID, std::vector<const HeadToHeadRecord*>& found) const;
+
+    // Forget every pairing
+    void clear();
+};
+
+#endif // HEAD_TO_HEAD_INDEX_H
@@ -0,0 +1,58 @@
+// Leaderboard.h
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <vector>
+#include "PlayerStatsTable.h"
+
+// What players are ranked by
+enum class LeaderboardMetric {
+    Wins,
+    LongestWinStreak,
+    MatchesPlayed,     // Decided matches (wins plus losses)
+    MetricCount
+};
+
+// One ranked player
+struct LeaderboardEntry {
+    int nameID;  // See PlayerNameIndex
+    int value;
+};
+
+// Top-K rankings over a PlayerStatsTable, one board per metric. A board is
+// built with a bounded heap of K entries over every player, O(N log K).
+// After that it is refreshed from the players the table reports as changed:
+// while values only grow (matches added on top of the history), a player
+// outside the top K can only enter by changing, so each change is merged
+// into the K entries directly. Anything else rebuilds the board.
+//
+// Ties go to the lower name ID, i.e. the player who appeared first.
+class Leaderboard {
+private:
+    struct Board {
+        std::vector<LeaderboardEntry> entries;  // Best first
+        int capacity = 0;                       // K the board was built for
+        bool built = false;
+    };
+
+    Board boards[static_cast<int>(LeaderboardMetric::MetricCount)];
+    std::vector<int> changes;  // Reused buffer for PlayerStatsTable::takeChanges
+
+    static int valueOf(const PlayerStats& stats, LeaderboardMetric metric);
+
+    // Rank every player from scratch
+    static void build(Board& board, LeaderboardMetric metric, const PlayerStatsTable& stats);
+
+    // Merge changed players into a built board
+    static void merge(Board& board, LeaderboardMetric metric, const PlayerStatsTable& stats, const std::vector<int>& nameIDs);
+
+public:
+    // Bring the boards up to date with the changes recorded in stats
+    void refresh(PlayerStatsTable& stats);
+
+    // The k best players by a metric, best first, written to top (whose
+    // storage is reused across calls). Call refresh first.
+    void getTop(LeaderboardMetric metric, int k, const PlayerStatsTable& stats, std::vector<LeaderboardEntry>& top);
+};
+
+#endif // LEADERBOARD_H
@@ -0,0 +1,49 @@
+// MappedFile.h
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// Read-only view of a whole file. On POSIX systems the file is memory-mapped;
+// elsewhere it is read into a single buffer. Either way the contents can be
+// scanned in place without per-line copies.
+class MappedFile {
+private:
+    const char* contents;
+    size_t length;
+    bool mapped;        // true if contents came from mmap
+    std::string buffer; // Fallback storage when mapping is unavailable
+
+public:
+    // Constructor
+    MappedFile();
+
+    // Destructor
+    ~MappedFile();
+
+    // Files are not copyable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Open and map a file, releasing any previous one
+    bool open(const std::string& path);
+
+    // Release the mapping
+    void close();
+
+    // Check whether a file is currently open
+    bool isOpen() const;
+
+    // Start of the file contents
+    const char* data() const;
+
+    // Size of the file in bytes
+    size_t size() const;
+
+    // Whole file as a string view
+    std::string_view view() const;
+};
+
+#endif // MAPPED_FILE_H
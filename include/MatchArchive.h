@@ -0,0 +1,165 @@
+// MatchArchive.h
+#ifndef MATCH_ARCHIVE_H
+#define MATCH_ARCHIVE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "MappedFile.h"
+#include "MatchScore.h"
+
+// Compressed, block-seekable archive of a match history, meant for old
+// seasons that are only searched occasionally.
+//
+// Layout (integers little-endian, sections 8-byte aligned):
+//   ArchiveHeader
+//   name offsets    uint32[nameCount + 1]   into the name bytes
+//   name bytes      player names, back to back
+//   blocks          ArchiveBlock[blockCount]
+//   block names     per block, the sorted codes of the names it uses as
+//                   delta varints
+//   data            one byte stream per block
+//
+// Each block holds up to BLOCK_MATCHES matches and can be decoded on its
+// own. Names inside a block are referred to by their index in the block's
+// sorted name list ("local index"): one byte when the block lists at most
+// 256 names, otherwise a varint. A match in a block stream is:
+//   zigzag varint   match ID minus the previous ID in the block (0 at the start)
+//   local index     player 1
+//   local index     player 2
+//   tag byte        bits 0-1 score kind (0 = raw text), bit 2 winner is
+//                   player 2, bit 3 winner is neither player, bits 4-7 the
+//                   set count, or for a set-count score ("2-1") the sets of
+//                   player 1 (bits 4-5) and player 2 (bits 6-7)
+//   [local index]   winner, if bit 3 is set
+//   score           one byte per set (games of player 1 in the low nibble),
+//                   nothing for a set-count score, or a varint length and
+//                   the raw text for kind 0
+// The block table keeps each block's ID range and name list, so ID
+// lookups and player scans skip blocks they cannot match.
+
+const char ARCHIVE_MAGIC[8] = { 'T', 'C', 'M', 'S', 'A', 'R', 'C', 'H' };
+const uint32_t ARCHIVE_VERSION = 1;
+
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;   // 0x01020304 as written by the producer
+    uint32_t matchCount;
+    uint32_t nameCount;
+    uint32_t blockCount;
+    uint32_t blockNameBytes;  // Size of the block names section
+    uint64_t nameOffsetsPos;
+    uint64_t nameBytesPos;
+    uint64_t blocksPos;
+    uint64_t blockNamesPos;
+    uint64_t dataPos;
+    uint64_t dataBytes;
+};
+
+struct ArchiveBlock {
+    int32_t minID;
+    int32_t maxID;
+    uint32_t matchCount;
+    uint32_t dataBytes;
+    uint64_t dataOffset;   // From the start of the data section
+    uint32_t namesOffset;  // Start of the block's name list in the block names section
+    uint32_t nameCount;
+};
+
+// One decoded match. The string views point into the archive mapping.
+struct ArchiveRecord {
+    int matchID;
+    uint32_t player1Code;
+    uint32_t player2Code;
+    std::string_view player1;
+    std::string_view player2;
+    std::string_view winner;
+    MatchScore packedScore;     // Unknown when the score is kept as text
+    std::string_view rawScore;  // Score text, when it could not be packed
+
+    // The score as it was written
+    std::string scoreText() const;
+};
+
+// Collects matches and writes them out as an archive file
+class MatchArchiveWriter {
+private:
+    std::unordered_map<std::string, uint32_t> nameCodes;
+    std::vector<std::string> names;
+    std::vector<ArchiveBlock> blocks;
+    std::string blockNames;
+    std::string data;
+
+    // Matches of the block being filled; encoded once its name list is known
+    struct PendingMatch {
+        int matchID;
+        uint32_t player1Code;
+        uint32_t player2Code;
+        uint32_t winnerCode;
+        uint8_t tag;
+        MatchScore score;
+        std::string rawScore;
+    };
+    std::vector<PendingMatch> pending;
+    std::vector<uint32_t> blockNameCodes;
+    std::vector<uint32_t> localIndex;  // name code -> index in the current block's name list
+
+    uint32_t encodeName(std::string_view name);
+    void flushBlock();
+
+public:
+    static const int BLOCK_MATCHES = 1024;
+
+    // Constructor
+    MatchArchiveWriter();
+
+    // Add the next match. Adding in ascending ID order keeps block ranges
+    // disjoint and the ID deltas small.
+    void add(int matchID, std::string_view p1, std::string_view p2, std::string_view w, std::string_view s);
+
+    // Write the archive to path
+    bool write(const std::string& path);
+};
+
+// Read-only view over an archive file
+class MatchArchiveReader {
+private:
+    MappedFile file;
+    ArchiveHeader header;
+
+    uint32_t column32(uint64_t pos, uint32_t index) const;
+    std::string_view name(uint32_t code) const;
+    ArchiveBlock block(int index) const;
+
+    // Name codes used in a block, ascending. Returns false if the list is corrupt.
+    bool readBlockNames(const ArchiveBlock& entry, std::vector<uint32_t>& codes) const;
+
+public:
+    // Constructor
+    MatchArchiveReader();
+
+    // Map and validate an archive. Returns false and sets error on failure.
+    bool open(const std::string& path, std::string& error);
+
+    // Number of matches in the archive
+    int getMatchCount() const;
+
+    // Number of blocks in the archive
+    int getBlockCount() const;
+
+    // Decode every match of one block, appending to records. Returns false
+    // if the block data is corrupt.
+    bool decodeBlock(int index, std::vector<ArchiveRecord>& records) const;
+
+    // Find a match by ID, decoding only the blocks whose range covers it
+    bool findMatch(int matchID, ArchiveRecord& record) const;
+
+    // Matches of a player (exact name, any case), decoding only the blocks
+    // that list the player. Returns the number of blocks decoded.
+    int findMatchesByPlayer(const std::string& playerName, std::vector<ArchiveRecord>& found) const;
+};
+
+#endif // MATCH_ARCHIVE_H
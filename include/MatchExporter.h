@@ -0,0 +1,98 @@
+// MatchExporter.h
+#ifndef MATCH_EXPORTER_H
+#define MATCH_EXPORTER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <climits>
+#include "Match.h"
+
+// Output formats for MatchHistory::exportMatches. For a compact columnar
+// copy of the history, see MatchArchive.h.
+enum class ExportFormat {
+    CSV,       // Header row, then one row per match; fields quoted when needed (RFC 4180)
+    JSONLines  // One JSON object per line
+};
+
+// Which matches an export writes. The filters are applied by walking the
+// indexes, so matches outside them are never visited.
+struct ExportFilter {
+    std::string player;  // Exact name, any case; empty for every player
+    int minID = INT_MIN;
+    int maxID = INT_MAX;
+};
+
+// Writes a file through a fixed-size buffer that is only flushed when it
+// fills up or the file is closed
+class BufferedFileWriter {
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool failed;
+
+    void flush();
+
+public:
+    static const size_t BUFFER_SIZE = 1 << 20;
+
+    // Constructor
+    BufferedFileWriter();
+
+    // Destructor (closes the file)
+    ~BufferedFileWriter();
+
+    // Writers are not copyable
+    BufferedFileWriter(const BufferedFileWriter&) = delete;
+    BufferedFileWriter& operator=(const BufferedFileWriter&) = delete;
+
+    // Create or truncate a file
+    bool open(const std::string& path);
+
+    // Append text
+    void write(std::string_view text);
+
+    // Append one character
+    void put(char c) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+    }
+
+    // Append an integer in decimal
+    void writeInt(long long value);
+
+    // Flush and close; with durable set, also fsync before closing.
+    // Returns false if any write failed.
+    bool close(bool durable = false);
+};
+
+// Writes matches one at a time in an export format
+class MatchExportWriter {
+private:
+    BufferedFileWriter out;
+    ExportFormat format;
+    long long rowCount;
+
+    void writeCSVField(std::string_view field);
+    void writeJSONString(std::string_view text);
+
+public:
+    // Constructor
+    MatchExportWriter();
+
+    // Create the file and write any header the format needs
+    bool open(const std::string& path, ExportFormat exportFormat);
+
+    // Write one match
+    void write(const Match& match);
+
+    // Flush and close. Returns false if any write failed.
+    bool close();
+
+    // Number of matches written
+    long long getRowCount() const;
+};
+
+#endif // MATCH_EXPORTER_H
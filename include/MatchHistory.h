@@ -3,11 +3,116 @@
 #define MATCH_HISTORY_H
 
 #include "Match.h"
-#include "Stack.h" 
+#include "VersionedStack.h"
+#include "HashIndex.h"
+#include "PlayerNameIndex.h"
+#include "MatchJournal.h"
+#include "PlayerStatsTable.h"
+#include "HeadToHeadIndex.h"
+#include "MatchScore.h"
+#include "OrderedIDIndex.h"
+#include "Leaderboard.h"
+#include "MatchExporter.h"
+
+// Order in which saveToFile writes matches. Loading (and the tail reader)
+// treat the last row as the newest, so OldestFirst round-trips recency;
+// most-recent-first is only a display order (viewRecentMatches).
+enum class SaveOrder {
+    OldestFirst,  // Order the matches were recorded in
+    ByMatchID     // Ascending match ID
+};
+
+// What addMatches does with a match whose ID is already taken, either in
+// the history or earlier in the same batch
+enum class ConflictPolicy {
+    Skip,     // Keep the match already there
+    Replace,  // Overwrite it where it is stored
+    FailFast  // Stop at the first conflict or invalid match and add nothing
+};
+
+// A batch entry that addMatches did not add as given
+struct ImportIssue {
+    int index;            // Position in the batch
+    int matchID;
+    std::string message;
+};
+
+// Outcome of addMatches
+struct ImportReport {
+    int added = 0;     // New IDs
+    int replaced = 0;  // Conflicts overwritten (ConflictPolicy::Replace)
+    int skipped = 0;   // Conflicts left alone (ConflictPolicy::Skip)
+    int rejected = 0;  // Matches that failed validation
+    bool aborted = false; // FailFast stopped the batch; the history is unchanged
+    std::vector<ImportIssue> issues; // Conflicts and rejected matches, in batch order
+};
+
+// Matches as of one published change, readable from any thread. A snapshot
+// is only the raw list of matches (oldest at 0): the ID, name, statistics
+// and leaderboard indexes are not versioned, so lookups, searches and
+// exports still have to run on the thread that changes the history.
+using MatchHistorySnapshot = VersionedStack<Match>::Snapshot;
 
 class MatchHistory {
 private:
-    Stack<Match> matchStack;  // Stack to store match history
+    VersionedStack<Match> matchStack; // Stack to store match history (published to snapshot readers)
+    HashIndex<int> idIndex;   // matchID -> position in matchStack (0 = oldest)
+    OrderedIDIndex orderedIDs; // matchIDs in ascending order -> positions in matchStack
+    PlayerNameIndex nameIndex; // player name -> positions of that player's matches
+    mutable PlayerStatsTable playerStats; // name ID -> aggregated results (streaks are rebuilt lazily)
+    HeadToHeadIndex headToHead; // pair of name IDs -> their meetings
+    mutable Leaderboard leaderboard; // Top players per metric, refreshed from playerStats changes
+    std::vector<uint64_t> packedScores; // position in matchStack -> MatchScore (player 1's side)
+    mutable MatchJournal journal; // Append-only log next to the loaded history file (saving may empty it)
+    bool journalEnabled;      // Journal each change instead of relying on full saves
+    int journalCompactionThreshold; // Fold the journal into the base file at this many records
+    std::string loadedPath;   // History file the matches in memory were loaded from ("" if none)
+
+    // Push a match on top of the history and index it
+    void appendMatch(Match match);
+
+    // Overwrite the match stored at a stack position, keeping indexes in sync
+    void replaceMatchAt(int position, Match match);
+
+    // Drop every match and index entry
+    void clearHistory();
+
+    // The history no longer reflects a loaded file: stop journaling against it
+    void detachFromFile();
+
+    // Which player won a match (1 or 2), or 0 if the winner is neither
+    int winnerSide(const Match& match) const;
+
+    // Add or take back a stored match in the player statistics and head-to-head records
+    void recordResult(int position, const Match& match, bool latest);
+    void unrecordResult(int position, const Match& match);
+
+    // Print up to ten known names resembling an unmatched query
+    void suggestSimilarNames(const std::string& query) const;
+
+    // Rebuild a player's streak and form if a replaced record left them stale
+    void refreshStreaks(int nameID) const;
+
+    // Add or replace a match by ID without prompting
+    bool upsertMatch(Match match);
+
+    // Replace the history with a text history file (-1 if unusable)
+    int loadTextRecords(const std::string& fullPath);
+
+    // Replace the history with a binary snapshot (-1 if unusable)
+    int loadSnapshotRecords(const std::string& snapshotPath);
+
+    // Apply the journal of a history file on top of the loaded matches
+    int replayJournal(const std::string& basePath);
+
+    // Log a change to the journal, compacting it when it grows too long
+    void recordInJournal(const Match& match);
+
+    // Write every match as a binary snapshot
+    bool writeSnapshot(const std::string& snapshotPath) const;
+
+    // Write every match as a history file; oldest first rebuilds the same stack on load
+    bool writeHistoryFile(const std::string& path, SaveOrder order = SaveOrder::OldestFirst, bool durable = false) const;
 
 public:
     // Constructor
@@ -16,25 +121,114 @@ public:
     // Add a new match to history
     void addMatch(const Match& match);
 
+    // Add a batch of matches without prompting. The batch is validated and
+    // checked for conflicts in one pass, applied in one go, and journaled
+    // with a single sync.
+    ImportReport addMatches(std::vector<Match> matches, ConflictPolicy policy);
+
     // View most recent matches (top N matches)
-    void viewRecentMatches(int count);
+    void viewRecentMatches(int count) const;
 
     // Search for matches by player name
-    void searchMatchesByPlayer(const std::string& playerName);
+    void searchMatchesByPlayer(const std::string& playerName) const;
 
     // Search for a match by ID
-    bool searchMatchByID(int matchID);
+    bool searchMatchByID(int matchID) const;
 
     // Save match history to file
-    bool saveToFile(const std::string& filename);
+    bool saveToFile(const std::string& filename, SaveOrder order = SaveOrder::OldestFirst) const;
 
-    // Load match history from file
+    // Stream the matches passing filter to path. With a player filter that
+    // player's matches are written oldest first, otherwise in ascending ID
+    // order. Memory use does not grow with the history. Returns the number
+    // of matches written, or -1 on error.
+    long long exportMatches(const std::string& path, ExportFormat format, const ExportFilter& filter) const;
+
+    // Load match history from file, or from its binary snapshot if that is newer
     bool loadFromFile(const std::string& filename);
 
+    // Write the history as the binary snapshot of the file it was loaded
+    // from (see MatchSnapshot.h). A snapshot is preferred over its text
+    // file when newer, so it is only ever written for the loaded file.
+    bool saveSnapshot() const;
+
+    // Write the history as a compressed archive in match ID order (see MatchArchive.h)
+    bool saveArchive(const std::string& archivePath) const;
+
+    // Replace the history with the contents of an archive. The history is
+    // then detached from any loaded file, so journaling stops until a
+    // history file is loaded again.
+    bool loadArchive(const std::string& archivePath);
+
     // Get the total number of matches in history
     int getTotalMatches() const;
+
+    // The matches as of the last completed add or load. Safe to call and
+    // read from other threads while this one keeps recording; every other
+    // method must stay on the thread that changes the history.
+    MatchHistorySnapshot snapshot() const;
+
+    // Highest match ID in the history, or 0 if empty
+    int getHighestMatchID() const;
+
+    // Look up a match by ID without printing, or nullptr if absent
+    const Match* findMatchByID(int matchID) const;
+
+    // Matches with low <= ID <= high, in ID order
+    void findMatchesInRange(int low, int high, std::vector<const Match*>& found) const;
+
+    // Up to count matches with IDs above afterID, in ID order. Returns the
+    // ID to pass as afterID for the following page.
+    int readMatchesAfter(int afterID, int count, std::vector<const Match*>& page) const;
+
+    // Aggregated results of a player (exact name, any case), or nullptr if unknown
+    const PlayerStats* getPlayerStats(const std::string& playerName) const;
+
+    // Display a player's aggregated results
+    void viewPlayerStats(const std::string& playerName) const;
+
+    // Meetings between two players (exact names, any case), or nullptr if they never met
+    const HeadToHeadRecord* getHeadToHead(const std::string& playerA, const std::string& playerB) const;
+
+    // Display the head-to-head record of two players
+    void viewHeadToHead(const std::string& playerA, const std::string& playerB) const;
+
+    // Display every opponent a player has met, with their record against each
+    void viewRivals(const std::string& playerName) const;
+
+    // The k best players by a metric, best first. top's storage is reused
+    // across calls.
+    void getLeaderboard(LeaderboardMetric metric, int k, std::vector<LeaderboardEntry>& top) const;
+
+    // Display the k best players by a metric
+    void viewLeaderboard(LeaderboardMetric metric, int k) const;
+
+    // Parsed score of the match stored at a position (0 = oldest)
+    MatchScore getScoreAt(int position) const;
+
+    // Totals over every readable score in the history
+    ScoreSummary summarizeAllScores() const;
+
+    // Display straight-set, tiebreak and game totals for the whole history
+    void viewScoreAnalytics() const;
+
+    // Append every add/replace to a journal next to the loaded history file.
+    // The journal opens once basePath (or any other history file) is loaded.
+    bool enableJournal(const std::string& basePath, FsyncPolicy policy = FsyncPolicy::EveryRecord, int syncInterval = 1);
+
+    // Stop journaling changes
+    void disableJournal();
+
+    // Number of records after which the journal is compacted automatically (0 = never)
+    void setJournalCompactionThreshold(int records);
+
+    // Fold the journal into the base history file and empty it
+    bool compactJournal();
 };
 
+// Print the counts and issues of an import
+void displayImportReport(const ImportReport& report);
+
 // Standalone function to run match history system
 void runMatchHistorySystem(MatchHistory& history);
 
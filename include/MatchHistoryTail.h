@@ -0,0 +1,79 @@
+// MatchHistoryTail.h
+#ifndef MATCH_HISTORY_TAIL_H
+#define MATCH_HISTORY_TAIL_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "Match.h"
+#include "HashIndex.h"
+
+// Reads a text file backwards from the end, one line at a time, in blocks
+// of BLOCK_SIZE bytes. Only the unread block and the line being assembled
+// are held in memory.
+class BackwardLineReader {
+private:
+    std::ifstream file;
+    std::streamoff unreadBytes;  // Bytes before this offset have not been read yet
+    std::string buffer;          // Read but not yet returned; always starts at offset unreadBytes
+
+public:
+    static const int BLOCK_SIZE = 64 * 1024;
+
+    // Constructor
+    BackwardLineReader();
+
+    // Open a file and position the reader at its end
+    bool open(const std::string& path);
+
+    // Close the file
+    void close();
+
+    // Check whether a file is open
+    bool isOpen() const;
+
+    // Read the line before the previous one (without its newline). Returns
+    // false once the start of the file has been passed.
+    bool previousLine(std::string& line);
+
+    // Check whether the line last returned was the first line of the file
+    bool atStart() const;
+};
+
+// Serves the most recent matches of a history file without loading it.
+// The journal (whose tail holds the newest changes) is read first, then
+// the base file, both from their ends. Each match ID is reported once,
+// with the version written last. Unlike a full load, a match that was
+// replaced is listed where its newest version was written rather than at
+// the position of the record it replaced.
+class MatchHistoryTail {
+private:
+    BackwardLineReader journalReader;
+    BackwardLineReader baseReader;
+    HashIndex<int> seenIDs;  // Match IDs already returned (or shadowed by a newer record)
+    int skippedRecords;      // Rows that could not be parsed
+
+    // Parse the next usable record, newest first. Returns false at the end.
+    bool nextRecord(Match& match);
+
+public:
+    // Constructor
+    MatchHistoryTail();
+
+    // Open a history file and its journal (if any) for reading from the end
+    bool open(const std::string& basePath);
+
+    // Close both files and forget the matches already returned
+    void close();
+
+    // Read up to count older matches, most recent first. Returns the number read.
+    int readPage(int count, std::vector<Match>& page);
+
+    // Check whether every record has been read
+    bool atEnd() const;
+
+    // Number of rows skipped because they could not be parsed
+    int getSkippedRecords() const;
+};
+
+#endif // MATCH_HISTORY_TAIL_H
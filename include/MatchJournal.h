@@ -0,0 +1,88 @@
+// MatchJournal.h
+#ifndef MATCH_JOURNAL_H
+#define MATCH_JOURNAL_H
+
+#include <string>
+#include <cstdio>
+#include <vector>
+#include "Match.h"
+
+// When journal appends are forced to stable storage
+enum class FsyncPolicy {
+    Never,        // Leave it to the operating system
+    EveryRecord,  // fsync after every appended record
+    EveryN        // fsync once every N records
+};
+
+// Flush a C stream and ask the OS to write the file to disk
+bool syncFile(std::FILE* file);
+
+// Ask the OS to write the directory holding path to disk, so a file renamed
+// into it survives a crash
+bool syncDirectory(const std::string& path);
+
+// Append-only log of match records kept next to a match history file
+// (e.g. data/match_history.txt.journal). Each added or replaced match is
+// written as one CSV row in the same format as the history file, and
+// replaying the rows in order over the base file reproduces the history.
+class MatchJournal {
+private:
+    std::string basePath;
+    std::string journalPath;
+    std::FILE* file;
+    FsyncPolicy policy;
+    int syncInterval;
+    int unsyncedRecords;
+    int recordCount;
+
+public:
+    // Constructor
+    MatchJournal();
+
+    // Destructor
+    ~MatchJournal();
+
+    // Journals are not copyable
+    MatchJournal(const MatchJournal&) = delete;
+    MatchJournal& operator=(const MatchJournal&) = delete;
+
+    // Journal file used for a given history file
+    static std::string journalPathFor(const std::string& basePath);
+
+    // Open (or create) the journal for basePath, appending to any records
+    // already in it
+    bool open(const std::string& basePath);
+
+    // Sync and close the journal
+    void close();
+
+    // Check whether the journal is open
+    bool isOpen() const;
+
+    // Choose when appended records are fsynced
+    void setFsyncPolicy(FsyncPolicy newPolicy, int interval = 1);
+
+    // When appends are forced to disk
+    FsyncPolicy getFsyncPolicy() const;
+
+    // Append one match record
+    bool append(const Match& match);
+
+    // Append several records with one write. Under FsyncPolicy::EveryRecord
+    // the batch is synced once, as a unit.
+    bool appendBatch(const std::vector<const Match*>& matches);
+
+    // Force appended records to stable storage
+    bool sync();
+
+    // Discard all records once they have been folded into the base file
+    bool reset();
+
+    // Number of records in the journal
+    int getRecordCount() const;
+
+    // History file this journal belongs to
+    const std::string& getBasePath() const;
+};
+
+#endif // MATCH_JOURNAL_H
@@ -0,0 +1,64 @@
+// MatchRecordParser.h
+#ifndef MATCH_RECORD_PARSER_H
+#define MATCH_RECORD_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Match.h"
+#include "ParallelLineParser.h"
+
+// Header line of match_history.txt
+const char MATCH_HISTORY_HEADER[] = "MatchID, Player1, Player2, Winner, Score";
+
+// One parsed row of match_history.txt. The string views point into the
+// buffer that was parsed and are only valid while that buffer is alive.
+struct MatchRecordView {
+    int matchID;
+    std::string_view player1;
+    std::string_view player2;
+    std::string_view winner;
+    std::string_view score;
+};
+
+// A row that could not be parsed
+struct ParseError {
+    int line;            // 1-based line number in the file
+    std::string message;
+};
+
+// Check that a header line names all five match history columns
+bool isMatchHistoryHeader(std::string_view line);
+
+// Append a match as one row (with its newline) in the history file format
+void appendMatchRecord(std::string& out, const Match& match);
+void appendMatchRecord(std::string& out, int matchID, std::string_view player1, std::string_view player2,
+                       std::string_view winner, std::string_view score);
+
+// Parse one data row. Returns nullptr on success, otherwise a description
+// of the first problem found.
+const char* parseMatchRecord(std::string_view line, MatchRecordView& record);
+
+// Parse every row in text, passing each valid record to sink(record, line)
+// and appending bad rows to errors. firstLine is the file line number of
+// the first row in text.
+template <typename Sink>
+void parseMatchRecords(std::string_view text, int firstLine, Sink&& sink, std::vector<ParseError>& errors) {
+    int lineNumber = firstLine;
+    MatchRecordView record;
+
+    while (!text.empty()) {
+        std::string_view line = takeLine(text);
+
+        if (line.empty()) {
+            errors.push_back({ lineNumber, "Empty line" });
+        } else if (const char* error = parseMatchRecord(line, record)) {
+            errors.push_back({ lineNumber, error });
+        } else {
+            sink(record, lineNumber);
+        }
+        lineNumber++;
+    }
+}
+
+#endif // MATCH_RECORD_PARSER_H
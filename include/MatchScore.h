@@ -0,0 +1,110 @@
+// MatchScore.h
+#ifndef MATCH_SCORE_H
+#define MATCH_SCORE_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+struct ScoreSummary;
+
+// A match score packed into 64 bits, always from player 1's side.
+//
+//   bits  0-39  up to MAX_SETS sets, one byte each: player 1 games in the
+//               low nibble, player 2 games in the high nibble
+//   bits 40-42  number of sets
+//   bits 43-47  tiebreak flag per set
+//   bits 48-49  kind (see Kind)
+//
+// A set-count score such as "2-1" (as written by the tournament scheduler)
+// is stored in the first byte with no sets listed. Scores that do not fit
+// (more than MAX_SETS sets, more than 15 games in a set) or do not parse
+// are Unknown; the score text remains the source of truth for those.
+class MatchScore {
+private:
+    uint64_t bits;
+
+    static const int KIND_SHIFT = 48;
+    static const int COUNT_SHIFT = 40;
+    static const int TIEBREAK_SHIFT = 43;
+
+public:
+    static const int MAX_SETS = 5;
+
+    enum Kind {
+        Unknown = 0,   // Could not be read
+        Games = 1,     // Games per set, e.g. "6-4 7-6"
+        SetsOnly = 2   // Sets won by each player, e.g. "2-1"
+    };
+
+    // Constructor (an Unknown score)
+    MatchScore() : bits(0) {}
+
+    // Wrap a packed value
+    explicit MatchScore(uint64_t packed) : bits(packed) {}
+
+    // Read a score. Pairs are "a-b" separated by spaces, optionally followed
+    // by a tiebreak score in parentheses, e.g. "7-6(5)". A 7-6 set also
+    // counts as a tiebreak. The score is taken from player 1's side unless
+    // that contradicts winnerSide (1 or 2), in which case it is read from
+    // the winner's side; 0 leaves it as written.
+    static MatchScore parse(std::string_view score, int winnerSide = 0);
+
+    // Build a score from packed set bytes (player 1 games in the low nibble).
+    // A 7-6 set is flagged as a tiebreak, as parse does.
+    static MatchScore fromSets(Kind kind, const uint8_t* sets, int setCount);
+
+    // The packed value
+    uint64_t getPacked() const { return bits; }
+
+    // Packed byte of one set (player 1 games in the low nibble)
+    uint8_t getSetByte(int set) const { return static_cast<uint8_t>(bits >> (set * 8)); }
+
+    Kind getKind() const { return static_cast<Kind>((bits >> KIND_SHIFT) & 3u); }
+
+    // Number of sets listed (0 for SetsOnly and Unknown)
+    int getSetCount() const { return static_cast<int>((bits >> COUNT_SHIFT) & 7u); }
+
+    // Games won in a set by player 1 (side 1) or player 2 (side 2)
+    int getGames(int set, int side) const {
+        return static_cast<int>((bits >> (set * 8 + (side == 1 ? 0 : 4))) & 15u);
+    }
+
+    // Check whether a set went to a tiebreak
+    bool isTiebreak(int set) const { return (bits >> (TIEBREAK_SHIFT + set)) & 1u; }
+
+    // Number of sets decided by a tiebreak
+    int getTiebreakCount() const;
+
+    // Sets won by player 1 (side 1) or player 2 (side 2)
+    int getSetsWon(int side) const;
+
+    // Games won by player 1 (side 1) or player 2 (side 2); 0 unless Games
+    int getGamesWon(int side) const;
+
+    // Check whether the loser did not win a set
+    bool isStraightSets() const;
+
+    // Score written out in the usual form, e.g. "6-4 7-6" or "2-1"; empty if Unknown
+    std::string toString() const;
+
+    // Works on the packed words directly
+    friend ScoreSummary summarizeScores(const uint64_t* packed, size_t count);
+};
+
+// Totals over many packed scores
+struct ScoreSummary {
+    long long scoredMatches = 0;      // Matches whose score could be read
+    long long straightSetMatches = 0; // ... won without dropping a set
+    long long gameScoredMatches = 0;  // ... with games per set
+    long long sets = 0;               // Sets listed in those matches
+    long long tiebreakSets = 0;       // ... decided by a tiebreak
+    long long tiebreakMatches = 0;    // Matches with at least one tiebreak
+    long long games = 0;              // Games played in those matches
+};
+
+// Aggregate a column of packed scores
+ScoreSummary summarizeScores(const uint64_t* packed, size_t count);
+
+#endif // MATCH_SCORE_H
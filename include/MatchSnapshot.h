@@ -0,0 +1,135 @@
+// MatchSnapshot.h
+#ifndef MATCH_SNAPSHOT_H
+#define MATCH_SNAPSHOT_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "MappedFile.h"
+
+// Binary, column-oriented snapshot of a match history.
+//
+// Layout (all integers little-endian, every section 8-byte aligned):
+//   SnapshotHeader
+//   name offsets    uint32[nameCount + 1]   into the name bytes
+//   name bytes      player names, back to back
+//   score offsets   uint32[scoreCount + 1]  into the score bytes
+//   score bytes     distinct score strings, back to back
+//   match IDs       int32[matchCount]
+//   player 1        uint32[matchCount]      name dictionary codes
+//   player 2        uint32[matchCount]
+//   winner          uint8[matchCount]       0 = player 1, 1 = player 2
+//   score           uint32[matchCount]      score dictionary codes
+//
+// Matches are stored oldest first, in the order they sit in the stack.
+// The file is read through a memory mapping, so fields come back as
+// string views into the file and no per-record allocation is needed.
+
+const char SNAPSHOT_MAGIC[8] = { 'T', 'C', 'M', 'S', 'S', 'N', 'A', 'P' };
+const uint32_t SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrderMark;   // 0x01020304 as written by the producer
+    uint32_t matchCount;
+    uint32_t nameCount;
+    uint32_t scoreCount;
+    uint32_t reserved;
+    uint64_t nameOffsetsPos;
+    uint64_t nameBytesPos;
+    uint64_t scoreOffsetsPos;
+    uint64_t scoreBytesPos;
+    uint64_t idsPos;
+    uint64_t player1Pos;
+    uint64_t player2Pos;
+    uint64_t winnerPos;
+    uint64_t scorePos;
+};
+
+// Collects matches and writes them out as a snapshot file
+class MatchSnapshotWriter {
+private:
+    std::unordered_map<std::string, uint32_t> nameCodes;
+    std::unordered_map<std::string, uint32_t> scoreCodes;
+    std::vector<std::string> names;
+    std::vector<std::string> scores;
+    std::vector<int32_t> ids;
+    std::vector<uint32_t> player1;
+    std::vector<uint32_t> player2;
+    std::vector<uint8_t> winner;
+    std::vector<uint32_t> score;
+
+    static uint32_t encode(std::string_view value, std::unordered_map<std::string, uint32_t>& codes,
+                           std::vector<std::string>& dictionary);
+
+public:
+    // Add the next match (oldest first). winner must equal one of the players.
+    void add(int matchID, std::string_view p1, std::string_view p2, std::string_view w, std::string_view s);
+
+    // Number of matches added so far
+    int getMatchCount() const;
+
+    // Write the snapshot to path
+    bool write(const std::string& path) const;
+};
+
+// Read-only view over a snapshot file
+class MatchSnapshotReader {
+private:
+    MappedFile file;
+    SnapshotHeader header;
+
+    uint32_t column32(uint64_t pos, uint32_t index) const;
+    std::string_view dictionaryEntry(uint64_t offsetsPos, uint64_t bytesPos, uint32_t code) const;
+
+public:
+    // Constructor
+    MatchSnapshotReader();
+
+    // Map and validate a snapshot. Returns false and sets error on failure.
+    bool open(const std::string& path, std::string& error);
+
+    // Number of matches in the snapshot
+    int getMatchCount() const;
+
+    // Fields of the match at index (0 = oldest)
+    int matchID(int index) const;
+    std::string_view player1(int index) const;
+    std::string_view player2(int index) const;
+    std::string_view winner(int index) const;
+    std::string_view score(int index) const;
+
+    // Dictionary codes of the match at index, for callers that decode each
+    // distinct name or score once instead of once per match
+    uint32_t player1Code(int index) const;
+    uint32_t player2Code(int index) const;
+    uint32_t scoreCode(int index) const;
+
+    // True if player 2 won the match at index
+    bool player2Won(int index) const;
+
+    // Sizes of the name and score dictionaries
+    int getNameCount() const;
+    int getScoreCount() const;
+
+    // Dictionary entries by code
+    std::string_view nameEntry(uint32_t code) const;
+    std::string_view scoreEntry(uint32_t code) const;
+};
+
+// Snapshot file used for a given history file
+std::string snapshotPathFor(const std::string& historyPath);
+
+// True if historyPath has a snapshot written after the text file was last changed
+bool isSnapshotCurrent(const std::string& historyPath);
+
+// Convert a match_history.txt style file to a snapshot
+bool convertCsvToSnapshot(const std::string& csvPath, const std::string& snapshotPath);
+
+// Convert a snapshot back to a match_history.txt style file
+bool convertSnapshotToCsv(const std::string& snapshotPath, const std::string& csvPath);
+
+#endif // MATCH_SNAPSHOT_H
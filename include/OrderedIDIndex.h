@@ -0,0 +1,80 @@
+// OrderedIDIndex.h
+#ifndef ORDERED_ID_INDEX_H
+#define ORDERED_ID_INDEX_H
+
+#include <vector>
+
+// Match IDs in ascending order, each with the stack position of its match.
+// Entries live in sorted blocks of at most BLOCK_SIZE; a full block is
+// split in two, so an insert moves at most one block's worth of entries.
+// Finding a key is a binary search over the block boundaries followed by
+// one inside the block. IDs that arrive in increasing order (the usual
+// case) are appended to the last block.
+class OrderedIDIndex {
+private:
+    struct Block {
+        std::vector<int> ids;        // Ascending
+        std::vector<int> positions;  // Parallel to ids
+    };
+
+    static const int BLOCK_SIZE = 256;
+
+    std::vector<Block> blocks;
+    int size;
+
+    // Block that should hold matchID
+    int findBlock(int matchID) const;
+
+public:
+    // Position in the index, walking in ascending ID order
+    class Cursor {
+    private:
+        const OrderedIDIndex* owner;
+        int block;
+        int offset;
+
+    public:
+        Cursor(const OrderedIDIndex* owner, int block, int offset) : owner(owner), block(block), offset(offset) {}
+
+        // Check whether the cursor points at an entry
+        bool isValid() const { return block < static_cast<int>(owner->blocks.size()); }
+
+        int matchID() const { return owner->blocks[block].ids[offset]; }
+        int position() const { return owner->blocks[block].positions[offset]; }
+
+        // Move to the next larger ID
+        void next() {
+            if (++offset == static_cast<int>(owner->blocks[block].ids.size())) {
+                block++;
+                offset = 0;
+            }
+        }
+    };
+
+    // Constructor
+    OrderedIDIndex();
+
+    // Add an ID, or update its position if already present
+    void insert(int matchID, int position);
+
+    // Cursor at the smallest ID
+    Cursor first() const;
+
+    // Cursor at the smallest ID not below matchID
+    Cursor seek(int matchID) const;
+
+    // Up to count positions of the matches with IDs above afterID, in ID
+    // order. Returns the ID to pass as afterID for the following page.
+    int readPage(int afterID, int count, std::vector<int>& positions) const;
+
+    // Largest ID stored, or 0 if empty
+    int getMaxID() const;
+
+    // Remove every ID
+    void clear();
+
+    // Number of IDs stored
+    int getSize() const;
+};
+
+#endif // ORDERED_ID_INDEX_H
@@ -0,0 +1,68 @@
+// ParallelLineParser.h
+#ifndef PARALLEL_LINE_PARSER_H
+#define PARALLEL_LINE_PARSER_H
+
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <exception>
+#include <cstddef>
+
+// Split off and return the first line of text (without the newline)
+std::string_view takeLine(std::string_view& text);
+
+// Split text into at most `parts` consecutive pieces, each ending just after
+// a newline (or at the end of the text), so no line straddles two pieces.
+std::vector<std::string_view> splitOnLineBoundaries(std::string_view text, int parts);
+
+// Number of worker threads to use for parsing a buffer of the given size.
+// Small inputs are parsed on the calling thread. The TCMS_PARSE_THREADS
+// environment variable overrides the hardware thread count.
+int chooseParseThreads(size_t bytes);
+
+// Number of lines in a piece of text (a final line without '\n' counts)
+int countLines(std::string_view text);
+
+// Parse text in line-aligned chunks on a pool of threads. parseChunk(chunk,
+// result) is called once per chunk and must only touch its own result.
+// Results are returned in file order so callers can merge them
+// sequentially and keep the same ordering as a single-threaded pass.
+template <typename Result, typename ParseChunk>
+std::vector<Result> parseInParallel(std::string_view text, int threads, ParseChunk parseChunk) {
+    std::vector<std::string_view> chunks = splitOnLineBoundaries(text, threads);
+    std::vector<Result> results(chunks.size());
+    if (chunks.empty()) {
+        return results;
+    }
+
+    std::vector<std::exception_ptr> failures(chunks.size());
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size() - 1);
+
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back([&, i]() {
+            try {
+                parseChunk(chunks[i], results[i]);
+            } catch (...) {
+                failures[i] = std::current_exception();
+            }
+        });
+    }
+
+    // The calling thread takes the first chunk
+    try {
+        parseChunk(chunks[0], results[0]);
+    } catch (...) {
+        failures[0] = std::current_exception();
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr& failure : failures) {
+        if (failure) std::rethrow_exception(failure);
+    }
+    return results;
+}
+
+#endif // PARALLEL_LINE_PARSER_H
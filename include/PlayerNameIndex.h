@@ -0,0 +1,126 @@
+// PlayerNameIndex.h
+#ifndef PLAYER_NAME_INDEX_H
+#define PLAYER_NAME_INDEX_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "Match.h"
+#include "HashIndex.h"
+
+// A name close to a fuzzy query
+struct NameCandidate {
+    int nameID;
+    int distance;  // Edits from the query to the name or one of its words
+};
+
+// Inverted index from player names to the matches they played.
+// Every distinct (case-folded) name is interned once and given an ID.
+// Each name keeps a posting list of stack positions in ascending order,
+// so walking it backwards yields the player's matches most recent first.
+// Names are further indexed by word token and by trigram so partial
+// queries are resolved against the distinct names, never the match rows.
+class PlayerNameIndex {
+private:
+    std::unordered_map<std::string, int> nameIDs;       // folded name -> name ID
+    std::vector<std::string> foldedNames;               // name ID -> folded name
+    std::vector<std::string> displayNames;              // name ID -> name as first seen
+    std::vector<std::vector<int>> postings;             // name ID -> stack positions (ascending)
+    std::unordered_map<std::string, std::vector<int>> tokenNames;  // folded token -> name IDs
+    HashIndex<uint32_t> trigramSlots;                   // packed trigram -> slot in trigramNames
+    std::vector<std::vector<int>> trigramNames;         // trigram slot -> name IDs (ascending)
+
+    // A whole name or a distinct word (pointers into tokenNames), laid out
+    // for the fuzzy search
+    struct FuzzyEntry {
+        uint32_t letters;              // letterMask of the folded text
+        int length;                    // Length of the folded text
+        int nameID;                    // Whole name, or -1 for a word
+        const std::string* token;      // Word, or nullptr for a whole name
+        const std::vector<int>* names; // Names containing the word
+    };
+    std::vector<FuzzyEntry> fuzzyEntries;
+
+    // Entries by the length of their text, so a scan only walks the lengths
+    // within maxDistance of the query
+    std::vector<std::vector<int>> entriesByLength;
+
+    // Entries by the trigrams of their text padded with two marks on each
+    // side. Each edit destroys at most three of the query's trigrams, so an
+    // entry within k edits shares all but 3k of them; entries found in none
+    // of the query's 3k + 1 rarest trigrams are never compared.
+    HashIndex<uint32_t> fuzzyGramSlots;             // packed padded trigram -> slot in fuzzyGramEntries
+    std::vector<std::vector<int>> fuzzyGramEntries; // slot -> entries containing it (ascending)
+    mutable std::vector<uint8_t> fuzzyGramSeen;     // entry -> already compared in the search running now
+
+    static uint32_t packTrigram(const std::string& text, size_t start);
+
+    // Distinct padded trigrams of a folded text, packed
+    static void paddedTrigrams(const std::string& folded, std::vector<uint32_t>& grams);
+
+    // Add a whole name (token == nullptr) or a word to the fuzzy search
+    void addFuzzyEntry(const std::string& folded, int nameID, const std::string* token, const std::vector<int>* names);
+
+    // Bit per letter (a-z) present in a folded string, plus one bit for
+    // everything else. Each edit adds or removes at most one letter, which
+    // rules out most names before computing a distance.
+    static uint32_t letterMask(const std::string& folded);
+
+    void indexName(int nameID);
+    void addPosting(int nameID, int position);
+    void removePosting(int nameID, int position);
+
+public:
+    // Lowercase a name for comparison
+    static std::string fold(const std::string& name);
+
+    // ID for a name, interning it if it has not been seen yet
+    int intern(const std::string& name);
+
+    // ID of a name (case-insensitive exact match), or -1
+    int findName(const std::string& name) const;
+
+    // IDs of names containing the given word token, e.g. a first name or surname
+    const std::vector<int>* findToken(const std::string& token) const;
+
+    // IDs of names containing the query as a substring (case-insensitive)
+    void findNamesContaining(const std::string& query, std::vector<int>& nameIDs) const;
+
+    // Names of players with matches that are within maxDistance edits of
+    // the query, as a whole or in one of their words (so "Djokovik" finds
+    // "Novak Djokovic"). Closest first; ties go to the player with more
+    // matches. Uses scratch space in the index, so searches must not run
+    // concurrently.
+    void findSimilarNames(const std::string& query, int maxDistance, std::vector<NameCandidate>& found) const;
+
+    // Record that the match stored at position involves its two players
+    void addMatch(int position, const Match& match);
+
+    // Same, for players already interned
+    void addMatch(int position, int player1ID, int player2ID);
+
+    // Make room for count more matches of an interned player
+    void reservePostings(int nameID, int count);
+
+    // Forget the match previously recorded at position
+    void removeMatch(int position, const Match& match);
+
+    // Stack positions of all matches involving a player whose name contains
+    // the query, most recent first and without duplicates
+    void findMatches(const std::string& query, std::vector<int>& positions) const;
+
+    // Stack positions of one player's matches (ascending)
+    const std::vector<int>& getPostings(int nameID) const;
+
+    // Name as it first appeared in the history
+    const std::string& getName(int nameID) const;
+
+    // Number of distinct names interned
+    int getNameCount() const;
+
+    // Remove all names and postings
+    void clear();
+};
+
+#endif // PLAYER_NAME_INDEX_H
@@ -0,0 +1,94 @@
+// PlayerStatsTable.h
+#ifndef PLAYER_STATS_TABLE_H
+#define PLAYER_STATS_TABLE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "MatchScore.h"
+
+// Aggregated results of one player across the match history
+struct PlayerStats {
+    int wins;
+    int losses;
+    int setsWon;
+    int setsLost;
+    int gamesWon;
+    int gamesLost;
+    int currentStreak;     // Positive: wins in a row, negative: losses in a row
+    int longestWinStreak;
+    uint32_t form;         // Bit i set if the i-th most recent decided match was a win
+    int formLength;        // Number of valid bits in form (at most FORM_LENGTH)
+
+    PlayerStats();
+};
+
+// Per-player statistics keyed by the name IDs of PlayerNameIndex, kept up
+// to date as matches are recorded. Counters are adjusted in O(1) per match.
+// A match added on top of the history is each player's most recent, so the
+// streak and form are extended in O(1) as well. Any other change (a record
+// replaced in place) only adjusts the counters and marks the players stale;
+// their streak and form are rebuilt from their results when next read.
+//
+// The table also notes which players changed, so rankings built on it (see
+// Leaderboard.h) can be refreshed from the changes alone while values only
+// grow, as they do when matches are added on top of the history.
+class PlayerStatsTable {
+private:
+    std::vector<PlayerStats> table;  // name ID -> statistics
+    std::vector<char> stale;         // name ID -> streak and form need rebuilding
+    int staleCount;
+    std::vector<int> changed;        // Name IDs changed since the last takeChanges (may repeat)
+    bool changedAll;                 // Some value may have gone down, or too many changes to list
+
+    PlayerStats& entry(int nameID);
+
+    // Note a change to a player for takeChanges
+    void noteChange(int nameID, bool mayDecrease);
+
+    void markStale(int nameID);
+
+    // Add (sign = 1) or subtract (sign = -1) one side of a match
+    void applyMatch(int nameID, int side, int winnerSide, MatchScore score, int sign, bool latest);
+
+public:
+    static const int FORM_LENGTH = 10;
+
+    // Constructor
+    PlayerStatsTable();
+
+    // Record a match for both players. winnerSide is 1 or 2 for the winning
+    // player, or 0 if the winner is neither player. latest is false when the
+    // match is not the players' most recent (it was stored in place).
+    void recordMatch(int player1ID, int player2ID, int winnerSide, MatchScore score, bool latest = true);
+
+    // Take back a match recorded earlier
+    void unrecordMatch(int player1ID, int player2ID, int winnerSide, MatchScore score);
+
+    // Check whether a player's streak and form must be rebuilt before use
+    bool isStale(int nameID) const;
+
+    // Check whether any player's streak and form must be rebuilt
+    bool hasStale() const;
+
+    // Rebuild a player's streak and form from their results, oldest first
+    // (1 = win, -1 = loss, 0 = undecided)
+    void rebuildStreaks(int nameID, const std::vector<int>& results);
+
+    // Statistics of a player, or nullptr if they have no matches recorded
+    const PlayerStats* find(int nameID) const;
+
+    // Move the name IDs changed since the last call into nameIDs (replacing
+    // its contents; IDs may repeat). Returns false if a value may have gone
+    // down or the list was dropped for being too long: every player must be
+    // treated as changed.
+    bool takeChanges(std::vector<int>& nameIDs);
+
+    // Number of name IDs with a table entry
+    int getSize() const;
+
+    // Forget every player
+    void clear();
+};
+
+#endif // PLAYER_STATS_TABLE_H
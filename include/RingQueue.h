@@ -0,0 +1,140 @@
+// RingQueue.h
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// FIFO queue stored in a circular buffer. Pushing and popping are O(1);
+// when the buffer fills up it doubles, unrolling the elements so the
+// oldest one is first again.
+template <typename T>
+class RingQueue {
+private:
+    std::vector<T> slots;  // Capacity is always zero or a power of two
+    int head;              // Position of the oldest element
+    int size;              // Number of elements
+
+    // Index into slots of the element at a position (0 = oldest)
+    int slot(int index) const { return (head + index) & (static_cast<int>(slots.size()) - 1); }
+
+    // Reallocate to hold at least capacity elements
+    void grow(int capacity);
+
+public:
+    // Constructor
+    RingQueue() : head(0), size(0) {}
+
+    // Add an element at the back
+    void push(const T& value);
+    void push(T&& value);
+
+    // Remove and return the front element
+    T pop();
+
+    // Access the front (oldest) element
+    T& front();
+    const T& front() const;
+
+    // Access the element at a position counted from the front (0 = oldest)
+    T& at(int index) { return slots[slot(index)]; }
+    const T& at(int index) const { return slots[slot(index)]; }
+
+    // Check if the queue is empty
+    bool isEmpty() const { return size == 0; }
+
+    // Get the number of elements
+    int getSize() const { return size; }
+
+    // Make room for at least capacity elements without further growth
+    void reserve(int capacity);
+
+    // Remove all elements
+    void clear();
+};
+
+// Implementation of RingQueue methods
+template <typename T>
+void RingQueue<T>::grow(int capacity) {
+    int newCapacity = slots.empty() ? 16 : static_cast<int>(slots.size());
+    while (newCapacity < capacity) {
+        newCapacity *= 2;
+    }
+
+    std::vector<T> newSlots(newCapacity);
+    for (int i = 0; i < size; i++) {
+        newSlots[i] = std::move(slots[slot(i)]);
+    }
+    slots.swap(newSlots);
+    head = 0;
+}
+
+// Add an element at the back
+template <typename T>
+void RingQueue<T>::push(const T& value) {
+    if (size == static_cast<int>(slots.size())) {
+        grow(size + 1);
+    }
+    slots[slot(size)] = value;
+    size++;
+}
+
+template <typename T>
+void RingQueue<T>::push(T&& value) {
+    if (size == static_cast<int>(slots.size())) {
+        grow(size + 1);
+    }
+    slots[slot(size)] = std::move(value);
+    size++;
+}
+
+// Remove and return the front element
+template <typename T>
+T RingQueue<T>::pop() {
+    if (size == 0) {
+        throw std::runtime_error("Queue underflow: Cannot pop from an empty queue.");
+    }
+    T value = std::move(slots[head]);
+    slots[head] = T();
+    head = slot(1);
+    size--;
+    return value;
+}
+
+// Access the front (oldest) element
+template <typename T>
+T& RingQueue<T>::front() {
+    if (size == 0) {
+        throw std::runtime_error("Queue is empty: Cannot access the front element.");
+    }
+    return slots[head];
+}
+
+template <typename T>
+const T& RingQueue<T>::front() const {
+    if (size == 0) {
+        throw std::runtime_error("Queue is empty: Cannot access the front element.");
+    }
+    return slots[head];
+}
+
+// Make room for at least capacity elements without further growth
+template <typename T>
+void RingQueue<T>::reserve(int capacity) {
+    if (capacity > static_cast<int>(slots.size())) {
+        grow(capacity);
+    }
+}
+
+// Remove all elements
+template <typename T>
+void RingQueue<T>::clear() {
+    for (int i = 0; i < size; i++) {
+        slots[slot(i)] = T();
+    }
+    head = 0;
+    size = 0;
+}
+
+#endif // RING_QUEUE_H
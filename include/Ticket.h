@@ -0,0 +1,14 @@
+// Ticket.h
+#ifndef TICKET_H
+#define TICKET_H
+
+#include <string>
+
+struct Ticket {
+    std::string ticketID;
+    std::string buyerName;
+    std::string type;  // VIP or Regular
+    std::string status;
+};
+
+#endif // TICKET_H
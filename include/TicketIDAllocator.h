@@ -0,0 +1,70 @@
+// TicketIDAllocator.h
+#ifndef TICKET_ID_ALLOCATOR_H
+#define TICKET_ID_ALLOCATOR_H
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <mutex>
+
+// Hands out ticket numbers in increasing order without touching the ticket
+// file. It is seeded once from the highest number seen at load time and
+// from its own high-water mark file, so a number is never issued twice even
+// if its ticket is no longer on file.
+//
+// The mark is not written per ticket: numbers are reserved in blocks of
+// BLOCK_SIZE, and the file is only rewritten (through a temporary file and
+// a rename) when a block runs out. On a clean shutdown the unused part of
+// the block is given back; after a crash it is skipped.
+//
+// IDs are formatted as "T" followed by at least three digits ("T007",
+// "T1000") and compared by their numeric part.
+class TicketIDAllocator {
+private:
+    std::atomic<long long> lastNumber;   // Highest number issued or seen
+    std::atomic<long long> reservedUpTo; // Highest number covered by the mark file
+    std::mutex markMutex;                // Serialises writes of the mark file
+    std::string markPath;                // High-water mark file
+
+    // Replace the mark file with value (temporary file, then rename)
+    bool writeMark(long long value) const;
+
+public:
+    static const int BLOCK_SIZE = 64;
+
+    // Constructor
+    explicit TicketIDAllocator(const std::string& markPath = "data/ticket_id.txt");
+
+    // Destructor (gives back unused reserved numbers)
+    ~TicketIDAllocator();
+
+    // Allocators are not copyable
+    TicketIDAllocator(const TicketIDAllocator&) = delete;
+    TicketIDAllocator& operator=(const TicketIDAllocator&) = delete;
+
+    // Read the persisted high-water mark, if any
+    void load();
+
+    // Make sure later numbers are above number (safe to call concurrently)
+    void seed(long long number);
+
+    // Issue the next number (safe to call concurrently). Returns false if
+    // the block holding it could not be reserved on disk; the number is
+    // still unique within this run.
+    bool allocate(long long& number);
+
+    // Highest number issued or seen so far
+    long long getLastNumber() const;
+
+    // Persist the last issued number so unused reserved numbers are not
+    // skipped next time. Returns false if the file cannot be written.
+    bool release();
+
+    // Numeric part of a ticket ID, or -1 if it is not "T" followed by digits
+    static long long parseNumber(std::string_view ticketID);
+
+    // Ticket ID for a number
+    static std::string format(long long number);
+};
+
+#endif // TICKET_ID_ALLOCATOR_H
@@ -0,0 +1,65 @@
+// TicketJournal.h
+#ifndef TICKET_JOURNAL_H
+#define TICKET_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "Ticket.h"
+
+// Append-only log of ticket changes kept next to the ticket file
+// (data/ticket_sales.txt.journal). Each line is one record:
+//   P,<ticketID>,<type>,<status>,<buyerName>   a ticket was purchased
+//   S,<ticketID>,<status>                      a ticket changed status
+// The buyer name comes last so it may contain commas. Replaying the
+// records in order over the ticket file reproduces the current tickets.
+class TicketJournal {
+private:
+    std::string journalPath;
+    std::FILE* file;
+    int recordCount;
+
+    // Write records and force them to disk
+    bool write(const std::string& records, int count);
+
+public:
+    // Constructor
+    TicketJournal();
+
+    // Destructor
+    ~TicketJournal();
+
+    // Journals are not copyable
+    TicketJournal(const TicketJournal&) = delete;
+    TicketJournal& operator=(const TicketJournal&) = delete;
+
+    // Journal file used for a given ticket file
+    static std::string journalPathFor(const std::string& basePath);
+
+    // Open (or create) the journal for basePath, appending to any records
+    // already in it
+    bool open(const std::string& basePath);
+
+    // Close the journal
+    void close();
+
+    // Check whether the journal is open
+    bool isOpen() const;
+
+    // Append a purchase record
+    bool appendPurchase(const Ticket& ticket);
+
+    // Append a status change record
+    bool appendStatus(const Ticket& ticket);
+
+    // Append a status change record for each ticket with one write and one sync
+    bool appendStatusBatch(const std::vector<const Ticket*>& tickets);
+
+    // Discard all records once they have been folded into the ticket file
+    bool reset();
+
+    // Number of records in the journal
+    int getRecordCount() const;
+};
+
+#endif // TICKET_JOURNAL_H
@@ -7,33 +7,97 @@
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <vector>
+#include "Ticket.h"
+#include "RingQueue.h"
+#include "HashIndex.h"
+#include "TicketIDAllocator.h"
+#include "TicketJournal.h"
 
 const int MAX_SPECTATORS = 50; // Venue capacity
+const char* const TICKET_SALES_FILE = "data/ticket_sales.txt";
 
-struct Ticket {
-    std::string ticketID;
-    std::string buyerName;
-    std::string type;  // VIP or Regular
-    std::string status;
+// Ticket statuses counted by TicketQueue. Cancelled, Rejected and Waiting
+// tickets are never queued, so they have no counter.
+enum class TicketStatus {
+    Pending,
+    Confirmed,
+    StatusCount
 };
 
+// Queue length limit from TCMS_TICKET_QUEUE_CAPACITY; 0 (the default) means
+// the queue grows as needed
+int chooseTicketQueueCapacity();
+
+// Priority queue of tickets: VIP tickets come before Regular ones, and each
+// tier is served in arrival order. Each tier is its own FIFO lane, so
+// enqueue and dequeue are O(1).
 class TicketQueue {
 private:
-    Ticket tickets[100]; // Manual array-based priority queue
-    int size;
+    RingQueue<Ticket> vipLane;
+    RingQueue<Ticket> regularLane;
+    int capacity; // Maximum number of queued tickets, 0 for no limit
+    int statusCounts[static_cast<int>(TicketStatus::StatusCount)]; // Queued tickets per status
+    TicketIDAllocator idAllocator; // Seeded by loadFromFile
+    HashIndex<long long> idIndex;  // Ticket number -> lane sequence * 2 (+1 in the VIP lane)
+    int vipPopped;                 // Tickets dequeued from each lane so far
+    int regularPopped;
+    int vipPendingCursor;          // Lane sequence before which no ticket is Pending
+    int regularPendingCursor;
+    TicketJournal journal;         // Changes since the ticket file was last written
+    int journalCompactionThreshold;
+
+    // Ticket at a position in queue order (VIP lane, then Regular lane)
+    Ticket& at(int index);
+
+    // Queued ticket with the given ID, or nullptr
+    Ticket* findTicket(const std::string& ticketID);
+
+    // Apply the journal on top of the loaded tickets; returns the records applied
+    int replayJournal();
+
+    // Report a failed journal write, and compact once the journal is long
+    void afterJournalWrite(bool written);
+
+    // Write every queued ticket to path, sorted by ticket number
+    bool writeTicketFile(const std::string& path);
+
+    // Counter for a status string, or nullptr if it is not counted
+    int* counterFor(const std::string& status);
+
+    // Change a queued ticket's status, keeping the counters in step. Only
+    // loading may set a ticket back to Pending, before any admission.
+    void setStatus(Ticket& ticket, const std::string& status);
+
+    // Confirm up to count Pending tickets of a lane, starting at its cursor
+    void admitFromLane(RingQueue<Ticket>& lane, int popped, int& cursor, int count, std::vector<const Ticket*>& admitted);
+
+    // Debug builds: check the counters against a full recount (only called
+    // where the queue is walked anyway, i.e. after loading and when saving)
+    void checkStatusCounts();
 
 public:
-    TicketQueue();
-    void enqueue(Ticket newTicket);
+    TicketQueue(int capacity = chooseTicketQueueCapacity());
+    bool enqueue(Ticket newTicket);
+    bool dequeue(Ticket& ticket);
+    int getSize() const;
+    bool addTicket(const Ticket& newTicket);
     void processTicketEntry();
+    void admitNext(int count, std::vector<const Ticket*>& admitted);
+    void admitAll(std::vector<const Ticket*>& admitted);
+    bool admitByID(const std::string& ticketID);
     void displayQueue();
-    void saveToFile();
+    bool saveToFile();
     void loadFromFile();
-    int countTicketsSold();
+    int getJournalRecordCount() const;
+    void setJournalCompactionThreshold(int records);
+    int countTicketsSold() const;
+    int getStatusCount(TicketStatus status) const;
+    std::string generateTicketID();
 };
 
-std::string generateTicketID();
 void purchaseTicket(TicketQueue& ticketQueue);
+void runGateMenu(TicketQueue& ticketQueue);
 void runTicketManager();
 
 #endif // TICKET_MANAGER_H
\ No newline at end of file
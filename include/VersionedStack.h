@@ -0,0 +1,405 @@
+// VersionedStack.h
+#ifndef VERSIONED_STACK_H
+#define VERSIONED_STACK_H
+
+#include <stdexcept>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+
+// A stack that other threads can read through immutable snapshots while
+// one writer keeps pushing.
+//
+// Elements live in fixed-size chunks reached through a chunk table. The writer publishes a version (the table plus the size at that
+// moment) with publish(); snapshot() hands out the latest published version
+// without taking a lock, and the snapshot keeps its table and chunks alive
+// for as long as it is held.
+//
+// Versions share their chunks. A snapshot never looks past its own size, so
+// pushing past the largest size published from the current table needs no
+// copy. replace(), and a push into a slot freed by pop(), copy the chunk they
+// touch (and the chunk table) only when they belong to an already published
+// version; pop() copies the top element out instead of moving it for the
+// same reason. A full chunk table is replaced by a larger copy rather than
+// grown in place. clear() starts a new table.
+//
+// Only one thread may call the writer methods (push, replace, clear,
+// publish); the writer's own reads see unpublished changes. Snapshots and
+// the writer read through the same View, so they offer the same methods.
+// T must be default constructible and assignable.
+template <typename T>
+class VersionedStack {
+private:
+    static const int CHUNK_SIZE = 64;
+
+    struct Chunk {
+        T items[CHUNK_SIZE];
+        unsigned long long generation;  // Publish count when the chunk was created
+
+        explicit Chunk(unsigned long long generation) : generation(generation) {}
+    };
+
+    struct Table {
+        std::vector<std::shared_ptr<Chunk>> chunks;  // Fixed length; unused entries are empty
+        unsigned long long generation;
+
+        Table(int capacity, unsigned long long generation) : chunks(capacity), generation(generation) {}
+    };
+
+    struct Version {
+        std::shared_ptr<const Table> table;
+        int size;
+        unsigned long long generation;  // 1 for the first version, then +1 per publish
+    };
+
+    std::shared_ptr<Table> table;  // Writer's current table
+    int size;                      // Size seen by the writer
+    int chunkCount;                // Chunks in use in the current table
+    unsigned long long generation; // Number of versions published so far
+    int publishedSize;             // Largest size published from the current table
+    std::atomic<std::shared_ptr<const Version>> published;
+
+    // Address of the element at the given position (0 = bottom)
+    static T* slot(const Table* table, int index) {
+        return table->chunks[index / CHUNK_SIZE]->items + index % CHUNK_SIZE;
+    }
+
+    // Slot for one more element, adding a chunk (and a larger table) as needed
+    T* reserveSlot();
+
+    // Slot at a position that may be overwritten, copying its chunk (and the
+    // table) first if a published version can see them
+    T* writableSlot(int index);
+
+public:
+    // Read-only forward iterator, walking from the top of the stack down
+    class const_iterator {
+    private:
+        const Table* table;
+        int index;  // Position of the current element (0 = bottom)
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() : table(nullptr), index(-1) {}
+        const_iterator(const Table* table, int index) : table(table), index(index) {}
+
+        reference operator*() const { return *slot(table, index); }
+        pointer operator->() const { return slot(table, index); }
+
+        const_iterator& operator++() {
+            index--;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            index--;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+
+    // View over the N most recently pushed elements, top first
+    class Range {
+    private:
+        const_iterator first;
+        const_iterator last;
+
+    public:
+        Range(const_iterator first, const_iterator last) : first(first), last(last) {}
+
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+    };
+
+    // Read access to the first size elements of a table. Does not own the
+    // table: the writer's view is valid until its next write, a snapshot's
+    // for as long as the snapshot is held.
+    class View {
+    private:
+        const Table* table;
+        int size;
+
+    public:
+        View(const Table* table, int size) : table(table), size(size) {}
+
+        // Check if the view is empty
+        bool isEmpty() const { return size == 0; }
+
+        // Get the number of elements
+        int getSize() const { return size; }
+
+        // Access the element at a position counted from the bottom (0 = oldest)
+        const T& at(int index) const {
+            if (index < 0 || index >= size) {
+                throw std::runtime_error("Stack index out of range.");
+            }
+            return *slot(table, index);
+        }
+
+        // Access the top element without copying it
+        const T& top() const {
+            if (isEmpty()) {
+                throw std::runtime_error("Cannot peek at an empty stack.");
+            }
+            return *slot(table, size - 1);
+        }
+
+        // Iterate from the top to the bottom
+        const_iterator begin() const { return const_iterator(table, size - 1); }
+        const_iterator end() const { return const_iterator(table, -1); }
+
+        // View of at most n elements starting from the top
+        Range topN(int n) const {
+            if (n < 0) n = 0;
+            if (n > size) n = size;
+            return Range(begin(), const_iterator(table, size - 1 - n));
+        }
+
+        // Call fn on every element, top first
+        template <typename Fn>
+        void for_each(Fn fn) const {
+            for (int i = size - 1; i >= 0; i--) {
+                fn(*slot(table, i));
+            }
+        }
+
+        // Return the first element (top first) matching pred, or nullptr
+        template <typename Pred>
+        const T* find_if(Pred pred) const {
+            for (int i = size - 1; i >= 0; i--) {
+                const T* element = slot(table, i);
+                if (pred(*element)) {
+                    return element;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    // One published version: a View that keeps its table and chunks alive.
+    // Cheap to copy; safe to read from any thread.
+    class Snapshot : public View {
+    private:
+        std::shared_ptr<const Version> version;
+
+    public:
+        Snapshot() : View(nullptr, 0) {}
+        explicit Snapshot(std::shared_ptr<const Version> version)
+            : View(version ? version->table.get() : nullptr, version ? version->size : 0),
+              version(std::move(version)) {}
+
+        // Which publish produced this version; later snapshots never have a smaller one
+        unsigned long long getGeneration() const { return version ? version->generation : 0; }
+    };
+
+    // Constructor
+    VersionedStack();
+
+    // Copy constructor: copies the writer's contents in O(n) and publishes them
+    VersionedStack(const VersionedStack<T>& other);
+
+    // Assignment operator
+    VersionedStack<T>& operator=(const VersionedStack<T>& other);
+
+    // Push an element onto the stack
+    void push(const T& value);
+
+    // Push an element onto the stack, moving it into place
+    void push(T&& value);
+
+    // Construct an element from args and move it onto the stack
+    template <typename... Args>
+    T& emplace(Args&&... args);
+
+    // Pop an element from the stack
+    T pop();
+
+    // Overwrite the element at a position (0 = bottom)
+    void replace(int index, T value);
+
+    // Check if the stack is empty
+    bool isEmpty() const { return size == 0; }
+
+    // Get the size of the stack
+    int getSize() const { return size; }
+
+    // Peek at the top element
+    T peek() const { return top(); }
+
+    // Access the top element without copying it
+    const T& top() const { return view().top(); }
+
+    // Access the element at a position counted from the bottom (0 = oldest)
+    const T& at(int index) const { return view().at(index); }
+
+    // Clear the stack
+    void clear();
+
+    // Make the writer's current contents visible to snapshot()
+    void publish();
+
+    // The latest published version
+    Snapshot snapshot() const;
+
+    // The writer's current contents, including unpublished changes
+    View view() const { return View(table.get(), size); }
+
+    // Iterate from the top of the stack to the bottom without modifying it
+    const_iterator begin() const { return view().begin(); }
+    const_iterator end() const { return view().end(); }
+
+    // View of at most n elements starting from the top
+    Range topN(int n) const { return view().topN(n); }
+
+    // Call fn on every element, top first
+    template <typename Fn>
+    void for_each(Fn fn) const { view().for_each(fn); }
+
+    // Return the first element (top first) matching pred, or nullptr
+    template <typename Pred>
+    const T* find_if(Pred pred) const { return view().find_if(pred); }
+};
+
+// Implementation of VersionedStack methods
+template <typename T>
+VersionedStack<T>::VersionedStack()
+    : table(std::make_shared<Table>(4, 0)), size(0), chunkCount(0), generation(0), publishedSize(0),
+      published(std::make_shared<const Version>(Version{ table, 0, 1 })) {
+    generation++;
+}
+
+// Copy constructor
+template <typename T>
+VersionedStack<T>::VersionedStack(const VersionedStack<T>& other) : VersionedStack() {
+    *this = other;
+}
+
+// Assignment operator
+template <typename T>
+VersionedStack<T>& VersionedStack<T>::operator=(const VersionedStack<T>& other) {
+    if (this == &other) {
+        return *this; // Self-assignment check
+    }
+
+    // Elements are stored bottom-up, so copy them straight across
+    clear();
+    for (int i = 0; i < other.size; i++) {
+        push(*slot(other.table.get(), i));
+    }
+    publish();
+    return *this;
+}
+
+template <typename T>
+T* VersionedStack<T>::reserveSlot() {
+    if (size == chunkCount * CHUNK_SIZE) {
+        if (chunkCount == static_cast<int>(table->chunks.size())) {
+            // Published versions may still read the old table, so copy it
+            std::shared_ptr<Table> larger = std::make_shared<Table>(chunkCount * 2, generation);
+            for (int i = 0; i < chunkCount; i++) {
+                larger->chunks[i] = table->chunks[i];
+            }
+            table = std::move(larger);
+        }
+        table->chunks[chunkCount] = std::make_shared<Chunk>(generation);
+        chunkCount++;
+    }
+    // A slot freed by pop() may still be visible to a published version
+    return size < publishedSize ? writableSlot(size) : slot(table.get(), size);
+}
+
+template <typename T>
+T* VersionedStack<T>::writableSlot(int index) {
+    if (table->chunks[index / CHUNK_SIZE]->generation != generation) {
+        // The slot is visible to a published version: copy the path to it
+        if (table->generation != generation) {
+            std::shared_ptr<Table> copy = std::make_shared<Table>(*table);
+            copy->generation = generation;
+            table = std::move(copy);
+        }
+        std::shared_ptr<Chunk> copy = std::make_shared<Chunk>(*table->chunks[index / CHUNK_SIZE]);
+        copy->generation = generation;
+        table->chunks[index / CHUNK_SIZE] = std::move(copy);
+    }
+    return slot(table.get(), index);
+}
+
+template <typename T>
+void VersionedStack<T>::push(const T& value) {
+    *reserveSlot() = value;
+    size++;
+}
+
+template <typename T>
+void VersionedStack<T>::push(T&& value) {
+    *reserveSlot() = std::move(value);
+    size++;
+}
+
+template <typename T>
+template <typename... Args>
+T& VersionedStack<T>::emplace(Args&&... args) {
+    T* element = reserveSlot();
+    *element = T(std::forward<Args>(args)...);
+    size++;
+    return *element;
+}
+
+template <typename T>
+T VersionedStack<T>::pop() {
+    if (isEmpty()) {
+        throw std::runtime_error("Cannot pop from an empty stack.");
+    }
+
+    // Emptied chunks are kept for reuse by later pushes
+    T* element = slot(table.get(), size - 1);
+    size--;
+    if (table->chunks[size / CHUNK_SIZE]->generation != generation) {
+        return *element; // Still visible to a published version
+    }
+    return std::move(*element);
+}
+
+template <typename T>
+void VersionedStack<T>::replace(int index, T value) {
+    if (index < 0 || index >= size) {
+        throw std::runtime_error("Stack index out of range.");
+    }
+
+    *writableSlot(index) = std::move(value);
+}
+
+template <typename T>
+void VersionedStack<T>::clear() {
+    table = std::make_shared<Table>(4, generation);
+    size = 0;
+    chunkCount = 0;
+    publishedSize = 0;
+}
+
+template <typename T>
+void VersionedStack<T>::publish() {
+    published.store(std::make_shared<const Version>(Version{ table, size, generation + 1 }),
+                    std::memory_order_release);
+    // Everything created so far is now visible to readers
+    if (size > publishedSize) publishedSize = size;
+    generation++;
+}
+
+template <typename T>
+typename VersionedStack<T>::Snapshot VersionedStack<T>::snapshot() const {
+    return Snapshot(published.load(std::memory_order_acquire));
+}
+
+#endif // VERSIONED_STACK_H
@@ -6,6 +6,7 @@
 #include <limits>
 #include <iomanip>
 #include <queue>
+#include <vector>
 #include <algorithm>
 #include "MatchHistory.h"
 
@@ -22,7 +23,7 @@ public:
     Player(int id = -1, std::string name = "", std::string username = "", std::string password = "");
 
     int getId() const;
-    std::string getName() const;
+    const std::string& getName() const;
     std::string getUsername() const;
     std::string getPassword() const;
     int getMatchesWon() const;
@@ -66,14 +67,33 @@ public:
 
 class TournamentMatchHistory {
 public:
-    TournamentMatch* completedMatches[100];
-    int completedCount;
+    std::vector<TournamentMatch*> completedMatches; // In completion order
 
     TournamentMatchHistory();
     void addCompletedMatch(TournamentMatch* match);
     void display() const;
 };
 
+// Passes matches completed in the scheduler on to the persistent match
+// history. completedMatches is read in completion order and the high-water
+// mark remembers how far, so each match is converted and recorded once.
+// Scheduler IDs restart at 101 every session, so recorded matches take the
+// next free history IDs.
+class TournamentHistorySync {
+private:
+    const TournamentMatchHistory& source;
+    MatchHistory& target;
+    int highWaterMark;  // completedMatches below this index have been passed on
+
+public:
+    TournamentHistorySync(const TournamentMatchHistory& source, MatchHistory& target);
+
+    // Record the matches completed since the last call; returns how many were added
+    int sync();
+
+    int getHighWaterMark() const;
+};
+
 class WinnerPriorityQueue {
 private:
     struct Node {
@@ -115,6 +135,6 @@ void generateKnockoutMatches(Player* winners[], int winnerCount, TournamentMatch
 void autoSimulateQualifierMatches(TournamentMatch* matches[], int& matchCount, TournamentMatchHistory& history);
 void autoSimulateStageMatches(TournamentMatch* matches[], int matchCount, const std::string& stage, TournamentMatchHistory& history);
 void autoSimulateFullTournament(TournamentMatch* matches[], int& matchCount, TournamentMatchHistory& history, int& matchIDCounter, WinnerPriorityQueue& pq);
-void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& bracket, TournamentMatchHistory& history);
+void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& bracket, TournamentMatchHistory& history, TournamentHistorySync& historySync);
 
 #endif // SCHEDULE_MATCHES_HPP
\ No newline at end of file
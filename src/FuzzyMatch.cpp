@@ -0,0 +1,103 @@
+// FuzzyMatch.cpp
+#include "../include/FuzzyMatch.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+// Prepare a pattern for matching
+FuzzyPattern::FuzzyPattern(std::string_view pattern)
+    : length(static_cast<int>(pattern.size())), blocks(std::max(1, (length + 63) / 64)) {
+    peq.assign(256 * blocks, 0);
+    for (int i = 0; i < length; i++) {
+        unsigned char c = static_cast<unsigned char>(pattern[i]);
+        uint64_t bit = 1ull << (i % 64);
+        peq[std::tolower(c) * blocks + i / 64] |= bit;
+        peq[std::toupper(c) * blocks + i / 64] |= bit;
+    }
+}
+
+// Edit distance from the pattern to text, giving up past maxDistance.
+//
+// The matrix has a row per pattern character and a column per text
+// character. Column by column, pv/mv mark the rows where the distance goes
+// up/down by one from the row above; score follows the last row. Row 0 is
+// the distance from the empty pattern, which grows by one every column.
+int FuzzyPattern::distance(std::string_view text, int maxDistance) const {
+    int n = static_cast<int>(text.size());
+    if (std::abs(n - length) > maxDistance) {
+        return maxDistance + 1;
+    }
+    if (length == 0) {
+        return n;
+    }
+
+    const uint64_t lastBit = 1ull << ((length - 1) % 64);
+    int score = length;
+
+    if (blocks == 1) {
+        uint64_t pv = ~0ull;
+        uint64_t mv = 0;
+        for (int j = 0; j < n; j++) {
+            uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+            uint64_t xv = eq | mv;
+            uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            uint64_t ph = mv | ~(xh | pv);
+            uint64_t mh = pv & xh;
+            if (ph & lastBit) {
+                score++;
+            } else if (mh & lastBit) {
+                score--;
+            }
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+
+            // Each remaining column can lower the score by at most one
+            if (score - (n - 1 - j) > maxDistance) {
+                return maxDistance + 1;
+            }
+        }
+        return score <= maxDistance ? score : maxDistance + 1;
+    }
+
+    // Several words per column: the change along each block's bottom row is
+    // carried into the top of the next block
+    std::vector<uint64_t> pv(blocks, ~0ull);
+    std::vector<uint64_t> mv(blocks, 0);
+    for (int j = 0; j < n; j++) {
+        const uint64_t* column = &peq[static_cast<unsigned char>(text[j]) * blocks];
+        int carry = 1;
+        for (int b = 0; b < blocks; b++) {
+            uint64_t high = b == blocks - 1 ? lastBit : 1ull << 63;
+            uint64_t eq = column[b];
+            uint64_t xv = eq | mv[b];
+            if (carry < 0) eq |= 1;
+            uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            uint64_t ph = mv[b] | ~(xh | pv[b]);
+            uint64_t mh = pv[b] & xh;
+            int out = (ph & high) ? 1 : ((mh & high) ? -1 : 0);
+            ph <<= 1;
+            mh <<= 1;
+            if (carry < 0) {
+                mh |= 1;
+            } else if (carry > 0) {
+                ph |= 1;
+            }
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            carry = out;
+        }
+        score += carry;
+
+        if (score - (n - 1 - j) > maxDistance) {
+            return maxDistance + 1;
+        }
+    }
+    return score <= maxDistance ? score : maxDistance + 1;
+}
+
+// Edit distance between two strings, ignoring ASCII case
+int editDistance(std::string_view a, std::string_view b) {
+    return FuzzyPattern(a).distance(b);
+}
@@ -0,0 +1,135 @@
+// HeadToHeadIndex.cpp
+#include "../include/HeadToHeadIndex.h"
+#include <algorithm>
+#include <utility>
+
+// Number of matches the pair has played
+int HeadToHeadRecord::getMeetings() const {
+    return static_cast<int>(positions.size());
+}
+
+// Stack position of their most recent match, or -1 if none remain
+int HeadToHeadRecord::getLastMeeting() const {
+    return positions.empty() ? -1 : positions.back();
+}
+
+// Wins of one player of the pair over the other
+int HeadToHeadRecord::getWins(int nameID) const {
+    return nameID == lowID ? lowWins : highWins;
+}
+
+uint64_t HeadToHeadIndex::packPair(int lowID, int highID) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(lowID)) << 32) | static_cast<uint32_t>(highID);
+}
+
+// Record for a pair, creating it if needed
+HeadToHeadRecord& HeadToHeadIndex::entry(int lowID, int highID) {
+    uint64_t key = packPair(lowID, highID);
+    int slot = pairSlots.find(key);
+    if (slot >= 0) {
+        return records[slot];
+    }
+
+    slot = static_cast<int>(records.size());
+    records.push_back(HeadToHeadRecord{ lowID, highID, 0, 0, {} });
+    pairSlots.insert(key, slot);
+
+    if (highID >= static_cast<int>(rivalries.size())) {
+        rivalries.resize(highID + 1);
+    }
+    rivalries[lowID].push_back(slot);
+    rivalries[highID].push_back(slot);
+    return records[slot];
+}
+
+// Record a match stored at position
+void HeadToHeadIndex::addMatch(int position, int player1ID, int player2ID, int winnerSide) {
+    if (player1ID < 0 || player2ID < 0 || player1ID == player2ID) {
+        return;
+    }
+
+    int lowID = std::min(player1ID, player2ID);
+    int highID = std::max(player1ID, player2ID);
+    HeadToHeadRecord& record = entry(lowID, highID);
+
+    std::vector<int>& list = record.positions;
+    if (list.empty() || list.back() < position) {
+        list.push_back(position); // Common case: a new match on top of the stack
+    } else {
+        auto it = std::lower_bound(list.begin(), list.end(), position);
+        if (it == list.end() || *it != position) list.insert(it, position);
+    }
+
+    if (winnerSide != 0) {
+        int winnerID = winnerSide == 1 ? player1ID : player2ID;
+        (winnerID == lowID ? record.lowWins : record.highWins)++;
+    }
+}
+
+// Make room for count more matches between two players
+void HeadToHeadIndex::reserveMatches(int player1ID, int player2ID, int count) {
+    if (player1ID < 0 || player2ID < 0 || player1ID == player2ID) {
+        return;
+    }
+    std::vector<int>& list = entry(std::min(player1ID, player2ID), std::max(player1ID, player2ID)).positions;
+    list.reserve(list.size() + count);
+}
+
+// Forget a match previously recorded at position
+void HeadToHeadIndex::removeMatch(int position, int player1ID, int player2ID, int winnerSide) {
+    if (player1ID < 0 || player2ID < 0 || player1ID == player2ID) {
+        return;
+    }
+
+    int lowID = std::min(player1ID, player2ID);
+    int highID = std::max(player1ID, player2ID);
+    int slot = pairSlots.find(packPair(lowID, highID));
+    if (slot < 0) {
+        return;
+    }
+    HeadToHeadRecord& record = records[slot];
+
+    std::vector<int>& list = record.positions;
+    auto it = std::lower_bound(list.begin(), list.end(), position);
+    if (it == list.end() || *it != position) {
+        return;
+    }
+    list.erase(it);
+
+    if (winnerSide != 0) {
+        int winnerID = winnerSide == 1 ? player1ID : player2ID;
+        (winnerID == lowID ? record.lowWins : record.highWins)--;
+    }
+}
+
+// Record of two players, or nullptr if they have never met
+const HeadToHeadRecord* HeadToHeadIndex::find(int playerA, int playerB) const {
+    if (playerA < 0 || playerB < 0 || playerA == playerB) {
+        return nullptr;
+    }
+    int slot = pairSlots.find(packPair(std::min(playerA, playerB), std::max(playerA, playerB)));
+    if (slot < 0 || records[slot].positions.empty()) {
+        return nullptr;
+    }
+    return &records[slot];
+}
+
+// Records of every pairing a player appears in
+void HeadToHeadIndex::findRivalries(int nameID, std::vector<const HeadToHeadRecord*>& found) const {
+    found.clear();
+    if (nameID < 0 || nameID >= static_cast<int>(rivalries.size())) {
+        return;
+    }
+    for (int slot : rivalries[nameID]) {
+        if (!records[slot].positions.empty()) {
+            found.push_back(&records[slot]);
+        }
+    }
+}
+
+// Forget every pairing
+void HeadToHeadIndex::clear() {
+    pairSlots.clear();
+    records.clear();
+    rivalries.clear();
+}
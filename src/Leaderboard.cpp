@@ -0,0 +1,115 @@
+// Leaderboard.cpp
+#include "../include/Leaderboard.h"
+#include <algorithm>
+
+namespace {
+
+// Ranking order: higher value first, then lower name ID
+bool ranksAbove(const LeaderboardEntry& a, const LeaderboardEntry& b) {
+    return a.value != b.value ? a.value > b.value : a.nameID < b.nameID;
+}
+
+}
+
+int Leaderboard::valueOf(const PlayerStats& stats, LeaderboardMetric metric) {
+    switch (metric) {
+        case LeaderboardMetric::Wins:
+            return stats.wins;
+        case LeaderboardMetric::LongestWinStreak:
+            return stats.longestWinStreak;
+        case LeaderboardMetric::MatchesPlayed:
+            return stats.wins + stats.losses;
+        default:
+            return 0;
+    }
+}
+
+// Rank every player from scratch
+void Leaderboard::build(Board& board, LeaderboardMetric metric, const PlayerStatsTable& stats) {
+    // Heap ordered so that its front is the weakest of the best K so far
+    std::vector<LeaderboardEntry>& heap = board.entries;
+    heap.clear();
+
+    for (int nameID = 0; nameID < stats.getSize(); nameID++) {
+        LeaderboardEntry entry = { nameID, valueOf(*stats.find(nameID), metric) };
+        if (entry.value <= 0) {
+            continue;
+        }
+        if (static_cast<int>(heap.size()) < board.capacity) {
+            heap.push_back(entry);
+            std::push_heap(heap.begin(), heap.end(), ranksAbove);
+        } else if (!heap.empty() && ranksAbove(entry, heap.front())) {
+            std::pop_heap(heap.begin(), heap.end(), ranksAbove);
+            heap.back() = entry;
+            std::push_heap(heap.begin(), heap.end(), ranksAbove);
+        }
+    }
+
+    std::sort_heap(heap.begin(), heap.end(), ranksAbove);
+    board.built = true;
+}
+
+// Merge changed players into a built board. Values have only grown, so an
+// entry only ever moves up.
+void Leaderboard::merge(Board& board, LeaderboardMetric metric, const PlayerStatsTable& stats, const std::vector<int>& nameIDs) {
+    std::vector<LeaderboardEntry>& entries = board.entries;
+
+    for (int nameID : nameIDs) {
+        LeaderboardEntry entry = { nameID, valueOf(*stats.find(nameID), metric) };
+        if (entry.value <= 0) {
+            continue;
+        }
+
+        size_t i = 0;
+        while (i < entries.size() && entries[i].nameID != nameID) {
+            i++;
+        }
+        if (i < entries.size()) {
+            entries[i].value = entry.value;
+        } else if (static_cast<int>(entries.size()) < board.capacity) {
+            entries.push_back(entry);
+        } else if (!entries.empty() && ranksAbove(entry, entries.back())) {
+            entries.back() = entry;
+            i = entries.size() - 1;
+        } else {
+            continue;
+        }
+
+        for (; i > 0 && ranksAbove(entries[i], entries[i - 1]); i--) {
+            std::swap(entries[i], entries[i - 1]);
+        }
+    }
+}
+
+// Bring the boards up to date with the changes recorded in stats
+void Leaderboard::refresh(PlayerStatsTable& stats) {
+    bool listed = stats.takeChanges(changes);
+    for (int m = 0; m < static_cast<int>(LeaderboardMetric::MetricCount); m++) {
+        Board& board = boards[m];
+        if (!board.built) {
+            continue;
+        }
+        if (listed) {
+            merge(board, static_cast<LeaderboardMetric>(m), stats, changes);
+        } else {
+            board.built = false;
+        }
+    }
+}
+
+// The k best players by a metric, best first
+void Leaderboard::getTop(LeaderboardMetric metric, int k, const PlayerStatsTable& stats, std::vector<LeaderboardEntry>& top) {
+    top.clear();
+    if (k <= 0 || metric == LeaderboardMetric::MetricCount) {
+        return;
+    }
+
+    Board& board = boards[static_cast<int>(metric)];
+    if (!board.built || k > board.capacity) {
+        board.capacity = std::max(k, board.capacity);
+        build(board, metric, stats);
+    }
+
+    size_t count = std::min(static_cast<size_t>(k), board.entries.size());
+    top.assign(board.entries.begin(), board.entries.begin() + count);
+}
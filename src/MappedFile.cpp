@@ -0,0 +1,101 @@
+// MappedFile.cpp
+#include "../include/MappedFile.h"
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Constructor
+MappedFile::MappedFile() : contents(nullptr), length(0), mapped(false) {
+}
+
+// Destructor
+MappedFile::~MappedFile() {
+    close();
+}
+
+// Open and map a file, releasing any previous one
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        // Nothing to map; an empty file is still a valid open file
+        ::close(fd);
+        contents = buffer.data();
+        return true;
+    }
+
+    void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address != MAP_FAILED) {
+        madvise(address, length, MADV_SEQUENTIAL);
+        contents = static_cast<const char*>(address);
+        mapped = true;
+        return true;
+    }
+    length = 0;
+#endif
+
+    // Fall back to reading the whole file into memory
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    buffer = ss.str();
+    contents = buffer.data();
+    length = buffer.size();
+    return true;
+}
+
+// Release the mapping
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapped) {
+        munmap(const_cast<char*>(contents), length);
+    }
+#endif
+    contents = nullptr;
+    length = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+// Check whether a file is currently open
+bool MappedFile::isOpen() const {
+    return contents != nullptr;
+}
+
+// Start of the file contents
+const char* MappedFile::data() const {
+    return contents;
+}
+
+// Size of the file in bytes
+size_t MappedFile::size() const {
+    return length;
+}
+
+// Whole file as a string view
+std::string_view MappedFile::view() const {
+    return std::string_view(contents, length);
+}
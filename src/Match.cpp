@@ -1,10 +1,11 @@
 // Match.cpp
 #include "../include/Match.h"
 #include <iostream>
+#include <utility>
 
 // Constructor
 Match::Match(int id, std::string p1, std::string p2, std::string w, std::string s)
-    : matchID(id), player1(p1), player2(p2), winner(w), score(s) {
+    : matchID(id), player1(std::move(p1)), player2(std::move(p2)), winner(std::move(w)), score(std::move(s)) {
 }
 
 // Default constructor
@@ -0,0 +1,507 @@
+// MatchArchive.cpp
+#include "../include/MatchArchive.h"
+#include "../include/PlayerNameIndex.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Tag byte fields
+const uint8_t TAG_KIND_MASK = 0x03;
+const uint8_t TAG_WINNER_P2 = 0x04;
+const uint8_t TAG_WINNER_OTHER = 0x08;
+const int TAG_SET_SHIFT = 4;
+const int TAG_SETS_P2_SHIFT = 6;  // Set-count scores: player 2's sets
+
+uint64_t alignTo8(uint64_t pos) {
+    return (pos + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Write a section and pad the file up to the next 8-byte boundary
+void writeSection(std::ofstream& out, const void* data, uint64_t bytes, uint64_t& pos) {
+    static const char padding[8] = {};
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    uint64_t end = pos + bytes;
+    uint64_t aligned = alignTo8(end);
+    out.write(padding, static_cast<std::streamsize>(aligned - end));
+    pos = aligned;
+}
+
+void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+// Read a varint, advancing p; false if it runs past end
+bool getVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        unsigned char byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}
+
+// The score as it was written
+std::string ArchiveRecord::scoreText() const {
+    return packedScore.getKind() == MatchScore::Unknown ? std::string(rawScore) : packedScore.toString();
+}
+
+// ===================== MatchArchiveWriter =====================
+
+// Constructor
+MatchArchiveWriter::MatchArchiveWriter() {}
+
+uint32_t MatchArchiveWriter::encodeName(std::string_view name) {
+    std::string key(name);
+    auto it = nameCodes.find(key);
+    if (it != nameCodes.end()) {
+        return it->second;
+    }
+    uint32_t code = static_cast<uint32_t>(names.size());
+    nameCodes.emplace(key, code);
+    names.push_back(std::move(key));
+    return code;
+}
+
+// Encode the block being filled and append it to the data section
+void MatchArchiveWriter::flushBlock() {
+    if (pending.empty()) {
+        return;
+    }
+
+    // The block's name list, and each name's index in it
+    std::sort(blockNameCodes.begin(), blockNameCodes.end());
+    blockNameCodes.erase(std::unique(blockNameCodes.begin(), blockNameCodes.end()), blockNameCodes.end());
+    localIndex.resize(names.size());
+    for (size_t i = 0; i < blockNameCodes.size(); i++) {
+        localIndex[blockNameCodes[i]] = static_cast<uint32_t>(i);
+    }
+    bool narrow = blockNameCodes.size() <= 256;
+    auto putName = [&](std::string& out, uint32_t code) {
+        if (narrow) {
+            out += static_cast<char>(localIndex[code]);
+        } else {
+            putVarint(out, localIndex[code]);
+        }
+    };
+
+    ArchiveBlock entry;
+    std::memset(&entry, 0, sizeof(entry));
+    entry.minID = pending.front().matchID;
+    entry.maxID = pending.front().matchID;
+    entry.matchCount = static_cast<uint32_t>(pending.size());
+    entry.dataOffset = data.size();
+    entry.namesOffset = static_cast<uint32_t>(blockNames.size());
+    entry.nameCount = static_cast<uint32_t>(blockNameCodes.size());
+
+    uint32_t previousCode = 0;
+    for (uint32_t code : blockNameCodes) {
+        putVarint(blockNames, code - previousCode);
+        previousCode = code;
+    }
+
+    int64_t previousID = 0;
+    for (const PendingMatch& match : pending) {
+        entry.minID = std::min(entry.minID, static_cast<int32_t>(match.matchID));
+        entry.maxID = std::max(entry.maxID, static_cast<int32_t>(match.matchID));
+
+        putVarint(data, zigzag(static_cast<int64_t>(match.matchID) - previousID));
+        previousID = match.matchID;
+        putName(data, match.player1Code);
+        putName(data, match.player2Code);
+        data += static_cast<char>(match.tag);
+        if (match.tag & TAG_WINNER_OTHER) {
+            putName(data, match.winnerCode);
+        }
+
+        if ((match.tag & TAG_KIND_MASK) == 0) {
+            putVarint(data, match.rawScore.size());
+            data += match.rawScore;
+        } else if ((match.tag & TAG_KIND_MASK) == MatchScore::Games) {
+            int sets = (match.tag >> TAG_SET_SHIFT) & 7;
+            for (int set = 0; set < sets; set++) {
+                data += static_cast<char>(match.score.getSetByte(set));
+            }
+        }
+    }
+
+    entry.dataBytes = static_cast<uint32_t>(data.size() - entry.dataOffset);
+    blocks.push_back(entry);
+
+    pending.clear();
+    blockNameCodes.clear();
+}
+
+// Add the next match
+void MatchArchiveWriter::add(int matchID, std::string_view p1, std::string_view p2, std::string_view w, std::string_view s) {
+    PendingMatch match;
+    match.matchID = matchID;
+    match.player1Code = encodeName(p1);
+    match.player2Code = encodeName(p2);
+    match.winnerCode = 0;
+    blockNameCodes.push_back(match.player1Code);
+    blockNameCodes.push_back(match.player2Code);
+
+    // Pack the score only if it comes back exactly as written
+    match.score = MatchScore::parse(s);
+    bool packed = match.score.getKind() != MatchScore::Unknown && match.score.toString() == s;
+
+    match.tag = 0;
+    if (packed && match.score.getKind() == MatchScore::SetsOnly) {
+        match.tag = static_cast<uint8_t>(MatchScore::SetsOnly | (match.score.getSetsWon(1) << TAG_SET_SHIFT) |
+                                         (match.score.getSetsWon(2) << TAG_SETS_P2_SHIFT));
+    } else if (packed) {
+        match.tag = static_cast<uint8_t>(MatchScore::Games | (match.score.getSetCount() << TAG_SET_SHIFT));
+    } else {
+        match.rawScore.assign(s.data(), s.size());
+    }
+
+    if (w == p2 && w != p1) {
+        match.tag |= TAG_WINNER_P2;
+    } else if (w != p1) {
+        match.tag |= TAG_WINNER_OTHER;
+        match.winnerCode = encodeName(w);
+        blockNameCodes.push_back(match.winnerCode);
+    }
+
+    pending.push_back(std::move(match));
+    if (static_cast<int>(pending.size()) == BLOCK_MATCHES) {
+        flushBlock();
+    }
+}
+
+// Write the archive to path
+bool MatchArchiveWriter::write(const std::string& path) {
+    flushBlock();
+
+    std::vector<uint32_t> nameOffsets;
+    std::string nameBytes;
+    nameOffsets.push_back(0);
+    for (const std::string& entry : names) {
+        nameBytes += entry;
+        nameOffsets.push_back(static_cast<uint32_t>(nameBytes.size()));
+    }
+
+    ArchiveHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = ARCHIVE_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    for (const ArchiveBlock& entry : blocks) {
+        header.matchCount += entry.matchCount;
+    }
+    header.nameCount = static_cast<uint32_t>(names.size());
+    header.blockCount = static_cast<uint32_t>(blocks.size());
+    header.blockNameBytes = static_cast<uint32_t>(blockNames.size());
+
+    // Lay the sections out one after another
+    uint64_t pos = alignTo8(sizeof(ArchiveHeader));
+    header.nameOffsetsPos = pos; pos = alignTo8(pos + nameOffsets.size() * sizeof(uint32_t));
+    header.nameBytesPos = pos;   pos = alignTo8(pos + nameBytes.size());
+    header.blocksPos = pos;      pos = alignTo8(pos + blocks.size() * sizeof(ArchiveBlock));
+    header.blockNamesPos = pos;  pos = alignTo8(pos + blockNames.size());
+    header.dataPos = pos;
+    header.dataBytes = data.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    pos = 0;
+    writeSection(out, &header, sizeof(header), pos);
+    writeSection(out, nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t), pos);
+    writeSection(out, nameBytes.data(), nameBytes.size(), pos);
+    writeSection(out, blocks.data(), blocks.size() * sizeof(ArchiveBlock), pos);
+    writeSection(out, blockNames.data(), blockNames.size(), pos);
+    writeSection(out, data.data(), data.size(), pos);
+
+    out.close();
+    return !out.fail();
+}
+
+// ===================== MatchArchiveReader =====================
+
+// Constructor
+MatchArchiveReader::MatchArchiveReader() {
+    std::memset(&header, 0, sizeof(header));
+}
+
+uint32_t MatchArchiveReader::column32(uint64_t pos, uint32_t index) const {
+    uint32_t value;
+    std::memcpy(&value, file.data() + pos + static_cast<uint64_t>(index) * sizeof(uint32_t), sizeof(value));
+    return value;
+}
+
+std::string_view MatchArchiveReader::name(uint32_t code) const {
+    uint32_t begin = column32(header.nameOffsetsPos, code);
+    uint32_t end = column32(header.nameOffsetsPos, code + 1);
+    return std::string_view(file.data() + header.nameBytesPos + begin, end - begin);
+}
+
+ArchiveBlock MatchArchiveReader::block(int index) const {
+    ArchiveBlock entry;
+    std::memcpy(&entry, file.data() + header.blocksPos + static_cast<uint64_t>(index) * sizeof(ArchiveBlock), sizeof(entry));
+    return entry;
+}
+
+// Name codes used in a block, ascending
+bool MatchArchiveReader::readBlockNames(const ArchiveBlock& entry, std::vector<uint32_t>& codes) const {
+    codes.clear();
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(file.data() + header.blockNamesPos + entry.namesOffset);
+    const unsigned char* end = reinterpret_cast<const unsigned char*>(file.data() + header.blockNamesPos + header.blockNameBytes);
+
+    uint64_t code = 0;
+    for (uint32_t i = 0; i < entry.nameCount; i++) {
+        uint64_t delta;
+        if (!getVarint(p, end, delta)) return false;
+        code += delta;
+        if (code >= header.nameCount) return false;
+        codes.push_back(static_cast<uint32_t>(code));
+    }
+    return true;
+}
+
+// Map and validate an archive
+bool MatchArchiveReader::open(const std::string& path, std::string& error) {
+    if (!file.open(path)) {
+        error = "Could not open archive " + path;
+        return false;
+    }
+
+    uint64_t size = file.size();
+    if (size < sizeof(ArchiveHeader)) {
+        error = "Archive is truncated.";
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) != 0) {
+        error = "Not a match history archive.";
+        return false;
+    }
+    if (header.version != ARCHIVE_VERSION) {
+        error = "Unsupported archive version " + std::to_string(header.version) + ".";
+        return false;
+    }
+    if (header.byteOrderMark != BYTE_ORDER_MARK) {
+        error = "Archive was written with a different byte order.";
+        return false;
+    }
+
+    // Every section must lie inside the file
+    struct Section { uint64_t pos; uint64_t bytes; } sections[] = {
+        { header.nameOffsetsPos, (header.nameCount + 1ULL) * sizeof(uint32_t) },
+        { header.blocksPos, static_cast<uint64_t>(header.blockCount) * sizeof(ArchiveBlock) },
+        { header.blockNamesPos, header.blockNameBytes },
+        { header.dataPos, header.dataBytes },
+    };
+    for (const Section& section : sections) {
+        if (section.pos > size || section.bytes > size - section.pos) {
+            error = "Archive is truncated.";
+            return false;
+        }
+    }
+
+    // Name offsets must be ordered and stay inside the name bytes
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i <= header.nameCount; i++) {
+        uint32_t offset = column32(header.nameOffsetsPos, i);
+        if (offset < previous || header.nameBytesPos + offset > size) {
+            error = "Archive name dictionary is corrupt.";
+            return false;
+        }
+        previous = offset;
+    }
+
+    // Blocks must point inside the data and block name sections
+    uint64_t matches = 0;
+    for (uint32_t i = 0; i < header.blockCount; i++) {
+        ArchiveBlock entry = block(static_cast<int>(i));
+        if (entry.dataOffset > header.dataBytes || entry.dataBytes > header.dataBytes - entry.dataOffset ||
+            entry.namesOffset > header.blockNameBytes ||
+            entry.minID > entry.maxID) {
+            error = "Archive block table is corrupt.";
+            return false;
+        }
+        matches += entry.matchCount;
+    }
+    if (matches != header.matchCount) {
+        error = "Archive block table is corrupt.";
+        return false;
+    }
+
+    return true;
+}
+
+// Number of matches in the archive
+int MatchArchiveReader::getMatchCount() const {
+    return static_cast<int>(header.matchCount);
+}
+
+// Number of blocks in the archive
+int MatchArchiveReader::getBlockCount() const {
+    return static_cast<int>(header.blockCount);
+}
+
+// Decode every match of one block, appending to records
+bool MatchArchiveReader::decodeBlock(int index, std::vector<ArchiveRecord>& records) const {
+    ArchiveBlock entry = block(index);
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(file.data() + header.dataPos + entry.dataOffset);
+    const unsigned char* end = p + entry.dataBytes;
+    bool narrow = entry.nameCount <= 256;
+    int64_t previousID = 0;
+
+    std::vector<uint32_t> localNames;
+    if (!readBlockNames(entry, localNames)) {
+        return false;
+    }
+
+    // Local index -> name code
+    auto getName = [&](uint32_t& code) {
+        uint64_t local;
+        if (narrow) {
+            if (p == end) return false;
+            local = *p++;
+        } else if (!getVarint(p, end, local)) {
+            return false;
+        }
+        if (local >= localNames.size()) return false;
+        code = localNames[local];
+        return true;
+    };
+
+    for (uint32_t i = 0; i < entry.matchCount; i++) {
+        ArchiveRecord record;
+        uint64_t delta;
+        if (!getVarint(p, end, delta) || !getName(record.player1Code) || !getName(record.player2Code) || p == end) {
+            return false;
+        }
+        uint8_t tag = *p++;
+
+        previousID += unzigzag(delta);
+        record.matchID = static_cast<int>(previousID);
+        record.player1 = name(record.player1Code);
+        record.player2 = name(record.player2Code);
+
+        if (tag & TAG_WINNER_OTHER) {
+            uint32_t winnerCode;
+            if (!getName(winnerCode)) return false;
+            record.winner = name(winnerCode);
+        } else {
+            record.winner = (tag & TAG_WINNER_P2) ? record.player2 : record.player1;
+        }
+
+        MatchScore::Kind kind = static_cast<MatchScore::Kind>(tag & TAG_KIND_MASK);
+        if (kind == MatchScore::Unknown) {
+            uint64_t length;
+            if (!getVarint(p, end, length) || length > static_cast<uint64_t>(end - p)) return false;
+            record.rawScore = std::string_view(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+            p += length;
+        } else if (kind == MatchScore::SetsOnly) {
+            uint8_t sets = static_cast<uint8_t>(((tag >> TAG_SET_SHIFT) & 3) | (((tag >> TAG_SETS_P2_SHIFT) & 3) << 4));
+            record.packedScore = MatchScore::fromSets(kind, &sets, 1);
+        } else {
+            int sets = (tag >> TAG_SET_SHIFT) & 7;
+            if (sets > end - p) return false;
+            record.packedScore = MatchScore::fromSets(kind, p, sets);
+            if (record.packedScore.getKind() == MatchScore::Unknown) return false;
+            p += sets;
+        }
+        records.push_back(record);
+    }
+    return true;
+}
+
+// Find a match by ID, decoding only the blocks whose range covers it
+bool MatchArchiveReader::findMatch(int matchID, ArchiveRecord& record) const {
+    std::vector<ArchiveRecord> records;
+    for (int i = 0; i < getBlockCount(); i++) {
+        ArchiveBlock entry = block(i);
+        if (matchID < entry.minID || matchID > entry.maxID) {
+            continue;
+        }
+
+        records.clear();
+        if (!decodeBlock(i, records)) {
+            return false;
+        }
+        for (const ArchiveRecord& candidate : records) {
+            if (candidate.matchID == matchID) {
+                record = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Matches of a player (exact name, any case), decoding only the blocks that list the player
+int MatchArchiveReader::findMatchesByPlayer(const std::string& playerName, std::vector<ArchiveRecord>& found) const {
+    found.clear();
+
+    // Every dictionary entry spelling this name (names are stored as written)
+    std::string folded = PlayerNameIndex::fold(playerName);
+    std::vector<uint32_t> codes;
+    for (uint32_t code = 0; code < header.nameCount; code++) {
+        std::string_view entry = name(code);
+        if (entry.size() == folded.size() && PlayerNameIndex::fold(std::string(entry)) == folded) {
+            codes.push_back(code);
+        }
+    }
+    if (codes.empty()) {
+        return 0;
+    }
+
+    std::vector<ArchiveRecord> records;
+    std::vector<uint32_t> blockCodes;
+    int blocksDecoded = 0;
+    for (int i = 0; i < getBlockCount(); i++) {
+        // Skip blocks whose name list has none of the codes
+        if (!readBlockNames(block(i), blockCodes)) {
+            break;
+        }
+        bool listed = false;
+        for (uint32_t code : codes) {
+            if (std::binary_search(blockCodes.begin(), blockCodes.end(), code)) {
+                listed = true;
+                break;
+            }
+        }
+        if (!listed) {
+            continue;
+        }
+
+        records.clear();
+        blocksDecoded++;
+        if (!decodeBlock(i, records)) {
+            break;
+        }
+        for (const ArchiveRecord& record : records) {
+            if (std::binary_search(codes.begin(), codes.end(), record.player1Code) ||
+                std::binary_search(codes.begin(), codes.end(), record.player2Code)) {
+                found.push_back(record);
+            }
+        }
+    }
+    return blocksDecoded;
+}
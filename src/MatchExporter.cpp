@@ -0,0 +1,153 @@
+// MatchExporter.cpp
+#include "../include/MatchExporter.h"
+#include "../include/MatchJournal.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+// Constructor
+BufferedFileWriter::BufferedFileWriter() : file(nullptr), buffer(BUFFER_SIZE), used(0), failed(false) {}
+
+// Destructor (closes the file)
+BufferedFileWriter::~BufferedFileWriter() {
+    close();
+}
+
+void BufferedFileWriter::flush() {
+    if (file != nullptr && used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) {
+        failed = true;
+    }
+    used = 0;
+}
+
+// Create or truncate a file
+bool BufferedFileWriter::open(const std::string& path) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    failed = file == nullptr;
+    used = 0;
+    return file != nullptr;
+}
+
+// Append text
+void BufferedFileWriter::write(std::string_view text) {
+    while (!text.empty()) {
+        if (used == buffer.size()) flush();
+        size_t n = std::min(text.size(), buffer.size() - used);
+        std::memcpy(buffer.data() + used, text.data(), n);
+        used += n;
+        text.remove_prefix(n);
+    }
+}
+
+// Append an integer in decimal
+void BufferedFileWriter::writeInt(long long value) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    write(std::string_view(digits, result.ptr - digits));
+}
+
+// Flush and close
+bool BufferedFileWriter::close(bool durable) {
+    if (file == nullptr) {
+        return !failed;
+    }
+    flush();
+    if (durable && !failed && !syncFile(file)) {
+        failed = true;
+    }
+    if (std::fclose(file) != 0) {
+        failed = true;
+    }
+    file = nullptr;
+    return !failed;
+}
+
+// Constructor
+MatchExportWriter::MatchExportWriter() : format(ExportFormat::CSV), rowCount(0) {}
+
+// Create the file and write any header the format needs
+bool MatchExportWriter::open(const std::string& path, ExportFormat exportFormat) {
+    format = exportFormat;
+    rowCount = 0;
+    if (!out.open(path)) {
+        return false;
+    }
+    if (format == ExportFormat::CSV) {
+        out.write("match_id,player1,player2,winner,score\n");
+    }
+    return true;
+}
+
+// Quote a CSV field if it contains a separator, quote or line break
+void MatchExportWriter::writeCSVField(std::string_view field) {
+    if (field.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.write(field);
+        return;
+    }
+    out.put('"');
+    for (char c : field) {
+        if (c == '"') out.put('"');
+        out.put(c);
+    }
+    out.put('"');
+}
+
+// Write a JSON string literal
+void MatchExportWriter::writeJSONString(std::string_view text) {
+    static const char hex[] = "0123456789abcdef";
+    out.put('"');
+    for (char c : text) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == '"' || c == '\\') {
+            out.put('\\');
+            out.put(c);
+        } else if (u < 0x20) {
+            out.write("\\u00");
+            out.put(hex[u >> 4]);
+            out.put(hex[u & 15]);
+        } else {
+            out.put(c);
+        }
+    }
+    out.put('"');
+}
+
+// Write one match
+void MatchExportWriter::write(const Match& match) {
+    if (format == ExportFormat::CSV) {
+        out.writeInt(match.matchID);
+        out.put(',');
+        writeCSVField(match.player1);
+        out.put(',');
+        writeCSVField(match.player2);
+        out.put(',');
+        writeCSVField(match.winner);
+        out.put(',');
+        writeCSVField(match.score);
+        out.put('\n');
+    } else {
+        out.write("{\"matchID\":");
+        out.writeInt(match.matchID);
+        out.write(",\"player1\":");
+        writeJSONString(match.player1);
+        out.write(",\"player2\":");
+        writeJSONString(match.player2);
+        out.write(",\"winner\":");
+        writeJSONString(match.winner);
+        out.write(",\"score\":");
+        writeJSONString(match.score);
+        out.write("}\n");
+    }
+    rowCount++;
+}
+
+// Flush and close
+bool MatchExportWriter::close() {
+    return out.close();
+}
+
+// Number of matches written
+long long MatchExportWriter::getRowCount() const {
+    return rowCount;
+}
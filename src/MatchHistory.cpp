@@ -1,10 +1,20 @@
 // MatchHistory.cpp
 #include "../include/MatchHistory.h"
+#include "../include/MappedFile.h"
+#include "../include/MatchRecordParser.h"
+#include "../include/MatchSnapshot.h"
+#include "../include/MatchHistoryTail.h"
+#include "../include/MatchArchive.h"
+#include "../include/ParallelLineParser.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <limits>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
 
 // Define a Player structure to store player information
 struct Player {
@@ -147,6 +157,8 @@ bool isValidScore(const std::string& score) {
         }
     }
 
+    // Scores the packed encoding cannot hold (long deciding sets, more than
+    // five sets) are still valid; they are stored as MatchScore::Unknown
     return hasDigit && hasSeparator;
 }
 
@@ -215,65 +227,254 @@ bool isValidFilename(const std::string& filename) {
 }
 
 // Constructor
-MatchHistory::MatchHistory() {
+MatchHistory::MatchHistory() : journalEnabled(false), journalCompactionThreshold(1000) {
     // No additional initialization needed
     // Player list will be loaded when entering the match history menu
 }
 
-// Add a new match to history
-void MatchHistory::addMatch(const Match& match) {
-    // Check for duplicate match ID
-    Stack<Match> tempStack;
-    bool isDuplicate = false;
+// Push a match on top of the history and index it
+void MatchHistory::appendMatch(Match match) {
+    matchStack.push(std::move(match));
+    int position = matchStack.getSize() - 1;
+    const Match& stored = matchStack.top();
+    idIndex.insert(stored.matchID, position);
+    orderedIDs.insert(stored.matchID, position);
+    nameIndex.addMatch(position, stored);
+    recordResult(position, stored, true);
+}
 
-    while (!matchStack.isEmpty() && !isDuplicate) {
-        Match current = matchStack.pop();
-        if (current.matchID == match.matchID) {
-            isDuplicate = true;
-            std::cout << "Warning: Match with ID " << match.matchID << " already exists." << std::endl;
-        }
-        tempStack.push(current);
+// Overwrite the match stored at a stack position, keeping indexes in sync
+void MatchHistory::replaceMatchAt(int position, Match match) {
+    const Match& previous = matchStack.at(position);
+    unrecordResult(position, previous);
+    nameIndex.removeMatch(position, previous);
+    matchStack.replace(position, std::move(match));
+    const Match& stored = matchStack.at(position);
+    idIndex.insert(stored.matchID, position);
+    nameIndex.addMatch(position, stored);
+    recordResult(position, stored, position == matchStack.getSize() - 1);
+}
+
+// Drop every match and index entry
+void MatchHistory::clearHistory() {
+    matchStack.clear();
+    idIndex.clear();
+    orderedIDs.clear();
+    nameIndex.clear();
+    playerStats.clear();
+    headToHead.clear();
+    packedScores.clear();
+}
+
+// The history no longer reflects a loaded file: stop journaling against it
+void MatchHistory::detachFromFile() {
+    journal.close();
+    loadedPath.clear();
+}
+
+// Which player won a match (1 or 2), or 0 if the winner is neither
+int MatchHistory::winnerSide(const Match& match) const {
+    if (match.winner == match.player1) return 1;
+    if (match.winner == match.player2) return 2;
+
+    // Same name written in a different case
+    int winnerID = nameIndex.findName(match.winner);
+    if (winnerID < 0) return 0;
+    if (winnerID == nameIndex.findName(match.player1)) return 1;
+    if (winnerID == nameIndex.findName(match.player2)) return 2;
+    return 0;
+}
+
+// Add a stored match to the player statistics and head-to-head records
+void MatchHistory::recordResult(int position, const Match& match, bool latest) {
+    int player1ID = nameIndex.findName(match.player1);
+    int player2ID = nameIndex.findName(match.player2);
+    int winner = winnerSide(match);
+    MatchScore score = MatchScore::parse(match.score, winner);
+    if (position == static_cast<int>(packedScores.size())) {
+        packedScores.push_back(score.getPacked());
+    } else {
+        packedScores[position] = score.getPacked();
     }
+    playerStats.recordMatch(player1ID, player2ID, winner, score, latest);
+    headToHead.addMatch(position, player1ID, player2ID, winner);
+}
+
+// Take back a stored match from the player statistics and head-to-head records
+void MatchHistory::unrecordResult(int position, const Match& match) {
+    int player1ID = nameIndex.findName(match.player1);
+    int player2ID = nameIndex.findName(match.player2);
+    int winner = winnerSide(match);
+    playerStats.unrecordMatch(player1ID, player2ID, winner, MatchScore(packedScores[position]));
+    headToHead.removeMatch(position, player1ID, player2ID, winner);
+}
+
+// Add or replace a match by ID without prompting
+bool MatchHistory::upsertMatch(Match match) {
+    int existing = idIndex.find(match.matchID);
+    if (existing >= 0) {
+        replaceMatchAt(existing, std::move(match));
+        return false;
+    }
+    appendMatch(std::move(match));
+    return true;
+}
 
-    // Restore the stack
-    while (!tempStack.isEmpty()) {
-        matchStack.push(tempStack.pop());
+// Log a change to the journal, compacting it when it grows too long
+void MatchHistory::recordInJournal(const Match& match) {
+    if (!journal.isOpen()) {
+        return;
     }
 
-    if (!isDuplicate) {
-        matchStack.push(match);
+    if (!journal.append(match)) {
+        std::cout << "Warning: Could not write to the match history journal." << std::endl;
+        return;
+    }
+
+    if (journalCompactionThreshold > 0 && journal.getRecordCount() >= journalCompactionThreshold) {
+        compactJournal();
+    }
+}
+
+// Add a new match to history
+void MatchHistory::addMatch(const Match& match) {
+    // Check for duplicate match ID
+    int existing = idIndex.find(match.matchID);
+
+    if (existing < 0) {
+        appendMatch(match);
+        recordInJournal(match);
         std::cout << "Match added to history successfully." << std::endl;
     } else {
+        std::cout << "Warning: Match with ID " << match.matchID << " already exists." << std::endl;
+
         char choice;
         std::cout << "Do you want to replace the existing match? (y/n): ";
         std::cin >> choice;
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
         if (choice == 'y' || choice == 'Y') {
-            // Remove existing match with the same ID
-            Stack<Match> tempStack2;
-            while (!matchStack.isEmpty()) {
-                Match current = matchStack.pop();
-                if (current.matchID != match.matchID) {
-                    tempStack2.push(current);
-                }
+            // Replace the existing record where it is stored
+            replaceMatchAt(existing, match);
+            recordInJournal(match);
+            std::cout << "Match replaced successfully." << std::endl;
+        } else {
+            std::cout << "Operation cancelled. Match not added." << std::endl;
+        }
+    }
+    matchStack.publish();
+}
+
+namespace {
+
+// Check that a match can be stored and written back as a history row.
+// Returns nullptr if it can, otherwise a description of the problem.
+const char* validateMatch(const Match& match) {
+    if (!isValidMatchID(match.matchID)) return "Match ID must be a positive integer.";
+    if (trim(match.player1).empty()) return "Player 1 name is empty.";
+    if (trim(match.player2).empty()) return "Player 2 name is empty.";
+    if (trim(match.winner).empty()) return "Winner name is empty.";
+    if (trim(match.score).empty()) return "Score is empty.";
+    if (match.winner != match.player1 && match.winner != match.player2) {
+        return "Winner must be one of the players.";
+    }
+    for (const std::string* field : { &match.player1, &match.player2, &match.winner }) {
+        if (field->find_first_of(",\r\n") != std::string::npos) return "Names may not contain commas or line breaks.";
+    }
+    if (match.score.find_first_of("\r\n") != std::string::npos) return "Score may not contain line breaks.";
+    return nullptr;
+}
+
+}
+
+// Add a batch of matches without prompting
+ImportReport MatchHistory::addMatches(std::vector<Match> matches, ConflictPolicy policy) {
+    ImportReport report;
+    int count = static_cast<int>(matches.size());
+
+    // Check the whole batch first: validation, and conflicts with the
+    // history or with earlier entries of the batch
+    HashIndex<int> batchIDs; // matchID -> first batch index
+    batchIDs.reserve(count);
+    std::vector<bool> accepted(count, false);
+    std::vector<int> changedIDs; // Accepted IDs in order of first appearance
+
+    for (int i = 0; i < count; i++) {
+        const Match& match = matches[i];
+
+        if (const char* error = validateMatch(match)) {
+            report.rejected++;
+            report.issues.push_back({ i, match.matchID, error });
+            if (policy == ConflictPolicy::FailFast) {
+                report.aborted = true;
+                return report;
             }
+            continue;
+        }
 
-            // Restore stack and add new match
-            while (!tempStack2.isEmpty()) {
-                matchStack.push(tempStack2.pop());
+        bool inHistory = idIndex.find(match.matchID) >= 0;
+        bool inBatch = batchIDs.find(match.matchID) >= 0;
+        if (inHistory || inBatch) {
+            report.issues.push_back({ i, match.matchID, inBatch ? "Match ID repeated in the batch."
+                                                                 : "Match ID already in the history." });
+            if (policy == ConflictPolicy::FailFast) {
+                report.aborted = true;
+                return report;
+            }
+            if (policy == ConflictPolicy::Skip) {
+                report.skipped++;
+                continue;
             }
+            report.replaced++;
+        } else {
+            report.added++;
+        }
+        if (!inBatch) {
+            batchIDs.insert(match.matchID, i);
+            changedIDs.push_back(match.matchID);
+        }
+        accepted[i] = true;
+    }
 
-            matchStack.push(match);
-            std::cout << "Match replaced successfully." << std::endl;
+    if (report.added + report.replaced == 0) {
+        return report;
+    }
+
+    // Apply in batch order; a repeated ID overwrites the earlier entry
+    idIndex.reserve(matchStack.getSize() + report.added);
+    for (int i = 0; i < count; i++) {
+        if (!accepted[i]) {
+            continue;
+        }
+        int existing = idIndex.find(matches[i].matchID);
+        if (existing >= 0) {
+            replaceMatchAt(existing, std::move(matches[i]));
         } else {
-            std::cout << "Operation cancelled. Match not added." << std::endl;
+            appendMatch(std::move(matches[i]));
+        }
+    }
+
+    // Journal the final version of every changed match once, new matches
+    // in the order they were appended, so a replay rebuilds the same stack
+    if (journal.isOpen()) {
+        std::vector<const Match*> changed;
+        changed.reserve(changedIDs.size());
+        for (int matchID : changedIDs) {
+            changed.push_back(&matchStack.at(idIndex.find(matchID)));
+        }
+        if (!journal.appendBatch(changed)) {
+            std::cout << "Warning: Could not write to the match history journal." << std::endl;
+        } else if (journalCompactionThreshold > 0 && journal.getRecordCount() >= journalCompactionThreshold) {
+            compactJournal();
         }
     }
+
+    matchStack.publish();
+    return report;
 }
 
 // View most recent matches (top N matches)
-void MatchHistory::viewRecentMatches(int count) {
+void MatchHistory::viewRecentMatches(int count) const {
     if (matchStack.isEmpty()) {
         std::cout << "No matches in history." << std::endl;
         return;
@@ -292,30 +493,21 @@ void MatchHistory::viewRecentMatches(int count) {
         count = totalMatches;
     }
 
-    // Create a temporary stack to restore the matches later
-    Stack<Match> tempStack;
     int displayed = 0;
 
     std::cout << "\n===== RECENT MATCHES =====" << std::endl;
 
-    // Display matches from the stack (up to count)
-    while (!matchStack.isEmpty() && displayed < count) {
-        Match currentMatch = matchStack.pop();
+    // Display matches from the top of the stack (up to count)
+    for (const Match& currentMatch : matchStack.topN(count)) {
         currentMatch.displayMatch();
-        tempStack.push(currentMatch);
         displayed++;
     }
 
-    // Restore matches back to original stack
-    while (!tempStack.isEmpty()) {
-        matchStack.push(tempStack.pop());
-    }
-
     std::cout << displayed << " matches displayed." << std::endl;
 }
 
 // Search for matches by player name
-void MatchHistory::searchMatchesByPlayer(const std::string& playerName) {
+void MatchHistory::searchMatchesByPlayer(const std::string& playerName) const {
     if (matchStack.isEmpty()) {
         std::cout << "No matches in history." << std::endl;
         return;
@@ -326,63 +518,61 @@ void MatchHistory::searchMatchesByPlayer(const std::string& playerName) {
         return;
     }
 
-    // Create temporary stacks
-    Stack<Match> tempStack;
-    Stack<Match> resultStack;
-
-    // Search through the stack
-    while (!matchStack.isEmpty()) {
-        Match currentMatch = matchStack.pop();
+    // Resolve the query against the distinct player names, then visit only
+    // the matches those players took part in
+    std::vector<int> positions;
+    nameIndex.findMatches(playerName, positions);
 
-        // Case-insensitive search
-        std::string player1Lower = currentMatch.player1;
-        std::string player2Lower = currentMatch.player2;
-        std::string searchLower = playerName;
-
-        // Convert to lowercase for case-insensitive comparison
-        for (char& c : player1Lower) c = std::tolower(c);
-        for (char& c : player2Lower) c = std::tolower(c);
-        for (char& c : searchLower) c = std::tolower(c);
-
-        // Check if player name matches
-        if (player1Lower.find(searchLower) != std::string::npos ||
-            player2Lower.find(searchLower) != std::string::npos) {
-            resultStack.push(currentMatch);
-        }
-
-        tempStack.push(currentMatch);
-    }
+    std::cout << "\n===== SEARCH RESULTS FOR '" << playerName << "' =====" << std::endl;
 
-    // Restore original stack
-    while (!tempStack.isEmpty()) {
-        matchStack.push(tempStack.pop());
+    // Display matching records in recency order
+    int count = 0;
+    for (int position : positions) {
+        matchStack.at(position).displayMatch();
+        count++;
     }
 
-    // Display search results
-    std::cout << "\n===== SEARCH RESULTS FOR '" << playerName << "' =====" << std::endl;
-
-    if (resultStack.isEmpty()) {
+    if (count == 0) {
         std::cout << "No matches found for " << playerName << std::endl;
+        suggestSimilarNames(playerName);
         return;
     }
 
-    // Display matches from result stack
-    Stack<Match> displayStack;  // To maintain order
-    while (!resultStack.isEmpty()) {
-        displayStack.push(resultStack.pop());
+    std::cout << count << " matches found." << std::endl;
+}
+
+// Print up to ten known names resembling an unmatched query
+void MatchHistory::suggestSimilarNames(const std::string& query) const {
+    const size_t maxSuggestions = 10;
+
+    // Names the query is part of, then names within a few typos of it
+    std::vector<int> suggestions;
+    nameIndex.findNamesContaining(query, suggestions);
+    if (suggestions.size() > maxSuggestions) {
+        suggestions.resize(maxSuggestions);
     }
 
-    int count = 0;
-    while (!displayStack.isEmpty()) {
-        displayStack.pop().displayMatch();
-        count++;
+    int maxDistance = query.size() <= 4 ? 1 : (query.size() <= 8 ? 2 : 3);
+    std::vector<NameCandidate> similar;
+    nameIndex.findSimilarNames(query, maxDistance, similar);
+    for (const NameCandidate& candidate : similar) {
+        if (suggestions.size() == maxSuggestions) break;
+        if (std::find(suggestions.begin(), suggestions.end(), candidate.nameID) == suggestions.end()) {
+            suggestions.push_back(candidate.nameID);
+        }
     }
 
-    std::cout << count << " matches found." << std::endl;
+    if (suggestions.empty()) {
+        return;
+    }
+    std::cout << "Did you mean:" << std::endl;
+    for (int nameID : suggestions) {
+        std::cout << "  " << nameIndex.getName(nameID) << std::endl;
+    }
 }
 
 // Search for a match by ID
-bool MatchHistory::searchMatchByID(int matchID) {
+bool MatchHistory::searchMatchByID(int matchID) const {
     if (matchStack.isEmpty()) {
         std::cout << "No matches in history." << std::endl;
         return false;
@@ -393,39 +583,20 @@ bool MatchHistory::searchMatchByID(int matchID) {
         return false;
     }
 
-    // Create temporary stack
-    Stack<Match> tempStack;
-    bool found = false;
-
-    // Search through the stack
     std::cout << "\n===== SEARCH RESULTS FOR MATCH ID " << matchID << " =====" << std::endl;
 
-    while (!matchStack.isEmpty()) {
-        Match currentMatch = matchStack.pop();
-
-        // Check if match ID matches
-        if (currentMatch.matchID == matchID) {
-            currentMatch.displayMatch();
-            found = true;
-        }
-
-        tempStack.push(currentMatch);
-    }
-
-    // Restore original stack
-    while (!tempStack.isEmpty()) {
-        matchStack.push(tempStack.pop());
-    }
-
-    if (!found) {
+    const Match* match = findMatchByID(matchID);
+    if (match == nullptr) {
         std::cout << "No match found with ID " << matchID << std::endl;
+        return false;
     }
 
-    return found;
+    match->displayMatch();
+    return true;
 }
 
 // Save match history to file
-bool MatchHistory::saveToFile(const std::string& filename) {
+bool MatchHistory::saveToFile(const std::string& filename, SaveOrder order) const {
     // Validate filename
     if (filename.empty()) {
         std::cout << "Error: Filename cannot be empty." << std::endl;
@@ -433,50 +604,57 @@ bool MatchHistory::saveToFile(const std::string& filename) {
     }
 
     std::string fullPath = "data/" + filename;
-    std::ofstream outFile(fullPath);
-
-    if (!outFile.is_open()) {
-        std::cout << "Error: Could not open file for writing." << std::endl;
+    // Emptying the journal is only safe once the new base file is on disk
+    bool replacesJournal = journal.isOpen() && journal.getBasePath() == fullPath;
+    bool durable = replacesJournal && journal.getFsyncPolicy() != FsyncPolicy::Never;
+    if (!writeHistoryFile(fullPath, order, durable)) {
+        std::cout << "Error: Could not write " << fullPath << "." << std::endl;
         std::cout << "Make sure you have write permissions for this location." << std::endl;
         return false;
     }
 
-    try {
-        // Write header with exact format from the sample file
-        outFile << "MatchID, Player1, Player2, Winner, Score" << std::endl;
-
-        // Create temporary stack
-        Stack<Match> tempStack;
+    // The journal's changes are now part of the base file
+    if (replacesJournal) {
+        journal.reset();
+    }
 
-        // Save all matches to file
-        while (!matchStack.isEmpty()) {
-            Match currentMatch = matchStack.pop();
+    std::cout << "Match history saved to " << fullPath << " successfully." << std::endl;
+    std::cout << "Total matches saved: " << matchStack.getSize() << std::endl;
+    return true;
+}
 
-            // Write match data to file with the exact format (notice spaces after commas)
-            outFile << currentMatch.matchID << ", "
-                    << currentMatch.player1 << ", "
-                    << currentMatch.player2 << ", "
-                    << currentMatch.winner << ", "
-                    << currentMatch.score << std::endl;
+// Stream the matches passing filter to path
+long long MatchHistory::exportMatches(const std::string& path, ExportFormat format, const ExportFilter& filter) const {
+    MatchExportWriter writer;
+    if (!writer.open(path, format)) {
+        std::cout << "Error: Could not open " << path << " for writing." << std::endl;
+        return -1;
+    }
 
-            tempStack.push(currentMatch);
+    if (!filter.player.empty()) {
+        // Only the player's own matches are visited
+        int nameID = nameIndex.findName(filter.player);
+        if (nameID >= 0) {
+            for (int position : nameIndex.getPostings(nameID)) {
+                const Match& match = matchStack.at(position);
+                if (match.matchID >= filter.minID && match.matchID <= filter.maxID) {
+                    writer.write(match);
+                }
+            }
         }
-
-        // Restore original stack
-        while (!tempStack.isEmpty()) {
-            matchStack.push(tempStack.pop());
+    } else {
+        // Only the requested ID range is visited
+        for (OrderedIDIndex::Cursor cursor = orderedIDs.seek(filter.minID);
+             cursor.isValid() && cursor.matchID() <= filter.maxID; cursor.next()) {
+            writer.write(matchStack.at(cursor.position()));
         }
-
-        outFile.close();
-        std::cout << "Match history saved to " << fullPath << " successfully." << std::endl;
-        std::cout << "Total matches saved: " << matchStack.getSize() << std::endl;
-        return true;
     }
-    catch (const std::exception& e) {
-        std::cout << "Error occurred while saving file: " << e.what() << std::endl;
-        outFile.close();
-        return false;
+
+    if (!writer.close()) {
+        std::cout << "Error: Could not write " << path << "." << std::endl;
+        return -1;
     }
+    return writer.getRowCount();
 }
 
 // Load match history from file
@@ -488,135 +666,440 @@ bool MatchHistory::loadFromFile(const std::string& filename) {
     }
 
     std::string fullPath = filename; // Already contains the path
-    std::ifstream inFile(fullPath);
 
-    if (!inFile.is_open()) {
+    // Prefer the binary snapshot when it is at least as new as the text file
+    int matchesLoaded = -1;
+    bool fromSnapshot = false;
+    if (isSnapshotCurrent(fullPath)) {
+        matchesLoaded = loadSnapshotRecords(snapshotPathFor(fullPath));
+        fromSnapshot = matchesLoaded >= 0;
+    }
+    if (!fromSnapshot) {
+        matchesLoaded = loadTextRecords(fullPath);
+        if (matchesLoaded < 0) {
+            // Whatever is in memory may not match the journaled file any more
+            detachFromFile();
+            matchStack.publish();
+            return false;
+        }
+    }
+
+    // Changes recorded since the base file was last written
+    int journalRecords = replayJournal(fullPath);
+    matchStack.publish();
+
+    if (matchesLoaded == 0 && journalRecords == 0) {
+        std::cout << "Warning: No valid matches were found in the file." << std::endl;
+        detachFromFile();
+        return false;
+    }
+
+    loadedPath = fullPath;
+    if (journalEnabled) {
+        journal.open(fullPath);
+    }
+
+    std::cout << "Match history loaded from " << fullPath << (fromSnapshot ? " (binary snapshot)" : "")
+              << " successfully." << std::endl;
+    std::cout << "Loaded " << matchesLoaded << " matches." << std::endl;
+    if (journalRecords > 0) {
+        std::cout << "Replayed " << journalRecords << " journal records." << std::endl;
+    }
+    return true;
+}
+
+namespace {
+
+// Rows parsed from one chunk of a history file
+struct ParsedMatchChunk {
+    std::vector<Match> matches;
+    std::vector<int> lines;          // Chunk-relative line of each match
+    std::vector<ParseError> errors;  // Chunk-relative line numbers
+    int lineCount = 0;
+};
+
+}
+
+// Replace the history with the rows of a text history file. Returns the
+// number of matches loaded, or -1 if the file could not be used.
+int MatchHistory::loadTextRecords(const std::string& fullPath) {
+    MappedFile inFile;
+
+    if (!inFile.open(fullPath)) {
         std::cout << "Error: Could not open file for reading: " << fullPath << std::endl;
         std::cout << "Make sure the file exists and you have read permissions." << std::endl;
-        return false;
+        return -1;
     }
 
-    try {
-        // Clear current history
-        int oldSize = matchStack.getSize();
-        while (!matchStack.isEmpty()) {
-            matchStack.pop();
+    std::string_view text = inFile.view();
+
+    // Check header line before touching the current history
+    if (text.empty()) {
+        std::cout << "Error occurred while loading file: File is empty or has invalid format." << std::endl;
+        return -1;
+    }
+    if (!isMatchHistoryHeader(takeLine(text))) {
+        std::cout << "Error occurred while loading file: File header does not match expected format." << std::endl;
+        return -1;
+    }
+
+    // Clear current history
+    clearHistory();
+
+    // Parse line-aligned chunks on worker threads; bad rows are collected
+    // rather than thrown. Line numbers are relative to each chunk for now.
+    std::vector<ParsedMatchChunk> chunks = parseInParallel<ParsedMatchChunk>(
+        text, chooseParseThreads(text.size()), [](std::string_view chunk, ParsedMatchChunk& result) {
+            // Sized up front: regrowing a vector of Match is most of the load on big files
+            result.lineCount = countLines(chunk);
+            result.matches.reserve(result.lineCount);
+            result.lines.reserve(result.lineCount);
+            parseMatchRecords(chunk, 0, [&](const MatchRecordView& record, int lineNumber) {
+                result.matches.emplace_back(record.matchID, std::string(record.player1), std::string(record.player2),
+                                            std::string(record.winner), std::string(record.score));
+                result.lines.push_back(lineNumber);
+            }, result.errors);
+        });
+
+    // Merge in file order so the stack ends up exactly as a sequential load would leave it
+    std::vector<ParseError> errors;
+    int matchesLoaded = 0;
+    int firstLine = 2; // Line 1 is the header
+
+    for (ParsedMatchChunk& chunk : chunks) {
+        for (size_t i = 0; i < chunk.matches.size(); i++) {
+            Match& match = chunk.matches[i];
+
+            // A repeated ID replaces the earlier row
+            int existing = idIndex.find(match.matchID);
+            if (existing >= 0) {
+                std::cout << "Warning: Duplicate Match ID " << match.matchID << " at line " << firstLine + chunk.lines[i]
+                          << ", replacing the earlier record." << std::endl;
+                replaceMatchAt(existing, std::move(match));
+            } else {
+                appendMatch(std::move(match));
+                matchesLoaded++;
+            }
+        }
+        for (ParseError& error : chunk.errors) {
+            error.line += firstLine;
+            errors.push_back(std::move(error));
         }
+        firstLine += chunk.lineCount;
+    }
 
-        std::string line;
-        int lineCount = 0;
-        int matchesLoaded = 0;
+    for (const ParseError& error : errors) {
+        std::cout << "Warning: " << error.message << " at line " << error.line << ", skipping this match." << std::endl;
+    }
+
+    return matchesLoaded;
+}
+
+// Replace the history with the contents of a binary snapshot. Returns the
+// number of matches loaded, or -1 if the snapshot could not be used.
+int MatchHistory::loadSnapshotRecords(const std::string& snapshotPath) {
+    MatchSnapshotReader reader;
+    std::string error;
 
-        // Skip header line
-        if (!std::getline(inFile, line)) {
-            throw std::runtime_error("File is empty or has invalid format.");
+    if (!reader.open(snapshotPath, error)) {
+        std::cout << "Warning: " << error << " Falling back to the text file." << std::endl;
+        return -1;
+    }
+
+    clearHistory();
+    int count = reader.getMatchCount();
+    idIndex.reserve(count);
+    packedScores.reserve(count);
+
+    // Decode each distinct name once: its text and its name ID
+    std::vector<std::string> names(reader.getNameCount());
+    std::vector<int> nameIDs(reader.getNameCount());
+    for (int code = 0; code < reader.getNameCount(); code++) {
+        names[code] = std::string(reader.nameEntry(code));
+        nameIDs[code] = nameIndex.intern(names[code]);
+    }
+
+    std::vector<std::string> scores(reader.getScoreCount());
+    for (int code = 0; code < reader.getScoreCount(); code++) {
+        scores[code] = std::string(reader.scoreEntry(code));
+    }
+
+    // Count every player's and every pairing's matches from the code
+    // columns, so their lists are sized once instead of growing row by row
+    std::vector<int> nameMatches(names.size());
+    HashIndex<uint64_t> pairSlots;
+    std::vector<uint64_t> pairs;
+    std::vector<int> pairMatches;
+    for (int i = 0; i < count; i++) {
+        uint32_t player1 = reader.player1Code(i);
+        uint32_t player2 = reader.player2Code(i);
+        nameMatches[player1]++;
+        nameMatches[player2]++;
+        uint64_t pair = (static_cast<uint64_t>(player1) << 32) | player2;
+        int slot = pairSlots.find(pair);
+        if (slot < 0) {
+            slot = static_cast<int>(pairMatches.size());
+            pairSlots.insert(pair, slot);
+            pairs.push_back(pair);
+            pairMatches.push_back(0);
         }
-        lineCount++;
+        pairMatches[slot]++;
+    }
+    for (size_t code = 0; code < names.size(); code++) {
+        nameIndex.reservePostings(nameIDs[code], nameMatches[code]);
+    }
+    for (size_t slot = 0; slot < pairs.size(); slot++) {
+        headToHead.reserveMatches(nameIDs[pairs[slot] >> 32], nameIDs[pairs[slot] & 0xffffffffu], pairMatches[slot]);
+    }
 
-        // Check header format
-        if (line.find("MatchID") == std::string::npos ||
-            line.find("Player1") == std::string::npos ||
-            line.find("Player2") == std::string::npos ||
-            line.find("Winner") == std::string::npos ||
-            line.find("Score") == std::string::npos) {
-            throw std::runtime_error("File header does not match expected format.");
+    // Each distinct score is parsed once per winning side, on first use
+    std::vector<uint64_t> parsedScores[2] = { std::vector<uint64_t>(scores.size()), std::vector<uint64_t>(scores.size()) };
+    std::vector<uint8_t> isParsed[2] = { std::vector<uint8_t>(scores.size()), std::vector<uint8_t>(scores.size()) };
+
+    for (int i = 0; i < count; i++) {
+        uint32_t player1 = reader.player1Code(i);
+        uint32_t player2 = reader.player2Code(i);
+        uint32_t scoreCode = reader.scoreCode(i);
+        // Same test as winnerSide(): the winner's name is compared with player 1's first
+        int winner = reader.player2Won(i) && player1 != player2 ? 2 : 1;
+        const std::string& winnerName = names[winner == 1 ? player1 : player2];
+
+        int matchID = reader.matchID(i);
+        if (idIndex.find(matchID) >= 0) {
+            // A repeated ID replaces the earlier match, as in a text file
+            upsertMatch(Match(matchID, names[player1], names[player2], winnerName, scores[scoreCode]));
+            continue;
         }
 
-        // Read match data
-        while (std::getline(inFile, line)) {
-            lineCount++;
+        if (!isParsed[winner - 1][scoreCode]) {
+            parsedScores[winner - 1][scoreCode] = MatchScore::parse(scores[scoreCode], winner).getPacked();
+            isParsed[winner - 1][scoreCode] = 1;
+        }
+        uint64_t packed = parsedScores[winner - 1][scoreCode];
+
+        // The same steps as appendMatch() and recordResult(), without
+        // looking the names up again
+        matchStack.push(Match(matchID, names[player1], names[player2], winnerName, scores[scoreCode]));
+        int position = matchStack.getSize() - 1;
+        idIndex.insert(matchID, position);
+        orderedIDs.insert(matchID, position);
+        nameIndex.addMatch(position, nameIDs[player1], nameIDs[player2]);
+        packedScores.push_back(packed);
+        playerStats.recordMatch(nameIDs[player1], nameIDs[player2], winner, MatchScore(packed), true);
+        headToHead.addMatch(position, nameIDs[player1], nameIDs[player2], winner);
+    }
+    return matchStack.getSize();
+}
 
-            if (line.empty()) {
-                std::cout << "Warning: Empty line at line " << lineCount << ", skipping." << std::endl;
-                continue;
-            }
+// Write the history as the binary snapshot of the file it was loaded from
+bool MatchHistory::saveSnapshot() const {
+    if (loadedPath.empty()) {
+        std::cout << "Error: No history file is loaded; load one before writing its snapshot." << std::endl;
+        return false;
+    }
 
-            std::stringstream ss(line);
-            std::string token;
+    std::string snapshotPath = snapshotPathFor(loadedPath);
+    if (!writeSnapshot(snapshotPath)) {
+        std::cout << "Error: Could not write " << snapshotPath << "." << std::endl;
+        return false;
+    }
+    std::cout << "Snapshot of " << matchStack.getSize() << " matches written to " << snapshotPath << "." << std::endl;
+    return true;
+}
 
-            try {
-                // Parse matchID
-                if (!std::getline(ss, token, ',')) {
-                    throw std::runtime_error("Failed to parse Match ID.");
-                }
-                int matchID;
-                try {
-                    matchID = std::stoi(token);
-                    if (matchID <= 0) {
-                        throw std::runtime_error("Invalid Match ID (must be positive).");
-                    }
-                } catch (const std::exception&) {
-                    throw std::runtime_error("Invalid Match ID format at line " + std::to_string(lineCount));
-                }
+// Write every match as a binary snapshot
+bool MatchHistory::writeSnapshot(const std::string& snapshotPath) const {
+    MatchSnapshotWriter writer;
+    for (int i = 0; i < matchStack.getSize(); i++) {
+        const Match& match = matchStack.at(i);
+        writer.add(match.matchID, match.player1, match.player2, match.winner, match.score);
+    }
+    return writer.write(snapshotPath);
+}
 
-                // Parse player1 (trim leading space)
-                if (!std::getline(ss, token, ',')) {
-                    throw std::runtime_error("Failed to parse Player 1 name.");
-                }
-                std::string player1 = token.substr(token[0] == ' ' ? 1 : 0);
-                if (player1.empty()) {
-                    throw std::runtime_error("Player 1 name is empty.");
-                }
+// Write the history as a compressed archive in match ID order
+bool MatchHistory::saveArchive(const std::string& archivePath) const {
+    MatchArchiveWriter writer;
+    for (OrderedIDIndex::Cursor cursor = orderedIDs.first(); cursor.isValid(); cursor.next()) {
+        const Match& match = matchStack.at(cursor.position());
+        writer.add(match.matchID, match.player1, match.player2, match.winner, match.score);
+    }
+    return writer.write(archivePath);
+}
 
-                // Parse player2 (trim leading space)
-                if (!std::getline(ss, token, ',')) {
-                    throw std::runtime_error("Failed to parse Player 2 name.");
-                }
-                std::string player2 = token.substr(token[0] == ' ' ? 1 : 0);
-                if (player2.empty()) {
-                    throw std::runtime_error("Player 2 name is empty.");
-                }
+// Replace the history with the contents of an archive
+bool MatchHistory::loadArchive(const std::string& archivePath) {
+    MatchArchiveReader reader;
+    std::string error;
+    if (!reader.open(archivePath, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return false;
+    }
 
-                // Parse winner (trim leading space)
-                if (!std::getline(ss, token, ',')) {
-                    throw std::runtime_error("Failed to parse Winner name.");
-                }
-                std::string winner = token.substr(token[0] == ' ' ? 1 : 0);
-                if (winner.empty()) {
-                    throw std::runtime_error("Winner name is empty.");
-                }
+    // The history will no longer be the journaled file's; stop journaling
+    // so neither later adds nor compaction touch that file
+    std::string previousPath = loadedPath;
+    detachFromFile();
+    clearHistory();
+    idIndex.reserve(reader.getMatchCount());
+
+    std::vector<ArchiveRecord> records;
+    for (int i = 0; i < reader.getBlockCount(); i++) {
+        records.clear();
+        if (!reader.decodeBlock(i, records)) {
+            std::cout << "Error: Archive block " << i << " is corrupt; stopped after "
+                      << matchStack.getSize() << " matches." << std::endl;
+            matchStack.publish();
+            return false;
+        }
+        for (const ArchiveRecord& record : records) {
+            upsertMatch(Match(record.matchID, std::string(record.player1), std::string(record.player2),
+                              std::string(record.winner), record.scoreText()));
+        }
+    }
 
-                // Parse score (trim leading space)
-                if (!std::getline(ss, token)) {
-                    throw std::runtime_error("Failed to parse Score.");
-                }
-                std::string score = token.substr(token[0] == ' ' ? 1 : 0);
-                if (score.empty()) {
-                    throw std::runtime_error("Score is empty.");
-                }
+    matchStack.publish();
+    std::cout << "Loaded " << matchStack.getSize() << " matches from archive " << archivePath << "." << std::endl;
+    if (!previousPath.empty()) {
+        std::cout << "Changes are no longer journaled to " << previousPath
+                  << "; save the history to keep them." << std::endl;
+    }
+    return true;
+}
 
-                // Validate that winner is one of the players
-                if (winner != player1 && winner != player2) {
-                    throw std::runtime_error("Winner must be one of the players.");
-                }
+// Apply the journal of a history file on top of the loaded matches
+int MatchHistory::replayJournal(const std::string& basePath) {
+    MappedFile journalFile;
+    if (!journalFile.open(MatchJournal::journalPathFor(basePath))) {
+        return 0; // No journal yet
+    }
 
-                // Create match and add to stack
-                Match match(matchID, player1, player2, winner, score);
-                matchStack.push(match);
-                matchesLoaded++;
-            }
-            catch (const std::exception& e) {
-                std::cout << "Warning: " << e.what() << " at line " << lineCount << ", skipping this match." << std::endl;
-            }
-        }
+    std::vector<ParseError> errors;
+    int replayed = 0;
 
-        inFile.close();
+    parseMatchRecords(journalFile.view(), 1, [&](const MatchRecordView& record, int) {
+        upsertMatch(Match(record.matchID, std::string(record.player1), std::string(record.player2),
+                          std::string(record.winner), std::string(record.score)));
+        replayed++;
+    }, errors);
 
-        if (matchesLoaded == 0) {
-            std::cout << "Warning: No valid matches were found in the file." << std::endl;
-            // Restore old stack if no matches were loaded
-            return false;
+    for (const ParseError& error : errors) {
+        std::cout << "Warning: " << error.message << " at journal line " << error.line << ", skipping this record." << std::endl;
+    }
+    return replayed;
+}
+
+// Write every match as a history file; oldest first rebuilds the same stack on load
+bool MatchHistory::writeHistoryFile(const std::string& path, SaveOrder order, bool durable) const {
+    BufferedFileWriter outFile;
+    if (!outFile.open(path)) {
+        return false;
+    }
+
+    // Write header with exact format from the sample file
+    outFile.write(MATCH_HISTORY_HEADER);
+    outFile.put('\n');
+
+    // Write match data with the exact format (notice spaces after commas);
+    // rows are buffered, not flushed one by one
+    std::string row;
+    auto writeMatch = [&outFile, &row](const Match& currentMatch) {
+        row.clear();
+        appendMatchRecord(row, currentMatch);
+        outFile.write(row);
+    };
+
+    if (order == SaveOrder::ByMatchID) {
+        // The ordered index is already sorted; no sort pass needed
+        for (OrderedIDIndex::Cursor cursor = orderedIDs.first(); cursor.isValid(); cursor.next()) {
+            writeMatch(matchStack.at(cursor.position()));
+        }
+    } else {
+        for (int i = 0; i < matchStack.getSize(); i++) {
+            writeMatch(matchStack.at(i));
         }
+    }
+    return outFile.close(durable);
+}
+
+// Append every add/replace to a journal next to the loaded history file
+bool MatchHistory::enableJournal(const std::string& basePath, FsyncPolicy policy, int syncInterval) {
+    journal.setFsyncPolicy(policy, syncInterval);
+    journalEnabled = true;
 
-        std::cout << "Match history loaded from " << fullPath << " successfully." << std::endl;
-        std::cout << "Loaded " << matchesLoaded << " matches." << std::endl;
+    // Until basePath is loaded, the journal would describe a different history
+    if (loadedPath != basePath) {
+        journal.close();
         return true;
     }
-    catch (const std::exception& e) {
-        std::cout << "Error occurred while loading file: " << e.what() << std::endl;
-        inFile.close();
+    if (!journal.open(basePath)) {
+        std::cout << "Warning: Could not open journal for " << basePath << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Stop journaling changes
+void MatchHistory::disableJournal() {
+    journal.close();
+    journalEnabled = false;
+}
+
+// Number of records after which the journal is compacted automatically (0 = never)
+void MatchHistory::setJournalCompactionThreshold(int records) {
+    journalCompactionThreshold = records;
+}
+
+// Fold the journal into the base history file and empty it
+bool MatchHistory::compactJournal() {
+    if (!journal.isOpen()) {
+        std::cout << "Journaling is not enabled." << std::endl;
+        return false;
+    }
+
+    // Only a history loaded from the base file may be written over it
+    if (loadedPath != journal.getBasePath()) {
+        std::cout << "Error: The history in memory was not loaded from " << journal.getBasePath()
+                  << "; not compacting." << std::endl;
+        return false;
+    }
+
+    // Write the new base file beside the old one, then swap it in. If we stop
+    // before the journal is emptied, replaying it again is harmless. Unless
+    // the journal is never synced, the file and the rename reach the disk
+    // before the journal is emptied.
+    const std::string basePath = journal.getBasePath();
+    const std::string tempPath = basePath + ".tmp";
+    const bool durable = journal.getFsyncPolicy() != FsyncPolicy::Never;
+
+    if (!writeHistoryFile(tempPath, SaveOrder::OldestFirst, durable)) {
+        std::cout << "Error: Could not write " << tempPath << " during journal compaction." << std::endl;
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(basePath.c_str());
+#endif
+    if (std::rename(tempPath.c_str(), basePath.c_str()) != 0) {
+        std::cout << "Error: Could not replace " << basePath << " during journal compaction." << std::endl;
         return false;
     }
+    if (durable && !syncDirectory(basePath)) {
+        std::cout << "Error: Could not sync the directory of " << basePath
+                  << "; keeping the journal." << std::endl;
+        return false;
+    }
+
+    journal.reset();
+
+    // Keep an existing snapshot in step with the rewritten base file
+    std::ifstream existingSnapshot(snapshotPathFor(basePath));
+    if (existingSnapshot.is_open()) {
+        existingSnapshot.close();
+        writeSnapshot(snapshotPathFor(basePath));
+    }
+
+    std::cout << "Journal compacted into " << basePath << "." << std::endl;
+    return true;
 }
 
 // Get the total number of matches in history
@@ -624,6 +1107,380 @@ int MatchHistory::getTotalMatches() const {
     return matchStack.getSize();
 }
 
+// Highest match ID in the history, or 0 if empty
+int MatchHistory::getHighestMatchID() const {
+    return orderedIDs.getMaxID();
+}
+
+// The matches as of the last completed add or load
+MatchHistorySnapshot MatchHistory::snapshot() const {
+    return matchStack.snapshot();
+}
+
+// Look up a match by ID without printing, or nullptr if absent
+const Match* MatchHistory::findMatchByID(int matchID) const {
+    int position = idIndex.find(matchID);
+    if (position < 0) {
+        return nullptr;
+    }
+    return &matchStack.at(position);
+}
+
+// Page through the newest matches of a history file, reading it from the
+// end so only the rows shown are ever parsed
+void browseLatestMatches(const std::string& fullPath) {
+    MatchHistoryTail tail;
+    if (!tail.open(fullPath)) {
+        std::cout << "Error: Could not open file for reading: " << fullPath << std::endl;
+        return;
+    }
+
+    int pageSize = getIntInput("Enter number of matches per page: ", [](int n) { return n > 0; });
+    std::vector<Match> page;
+    int displayed = 0;
+
+    std::cout << "\n===== LATEST MATCHES IN " << fullPath << " =====" << std::endl;
+    while (tail.readPage(pageSize, page) > 0) {
+        for (const Match& match : page) {
+            match.displayMatch();
+        }
+        displayed += static_cast<int>(page.size());
+
+        if (static_cast<int>(page.size()) < pageSize || tail.atEnd()) {
+            break;
+        }
+
+        char more;
+        std::cout << "Show older matches? (y/n): ";
+        std::cin >> more;
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (more != 'y' && more != 'Y') {
+            break;
+        }
+    }
+
+    if (displayed == 0) {
+        std::cout << "No matches found in " << fullPath << "." << std::endl;
+    } else {
+        std::cout << displayed << " matches displayed." << std::endl;
+    }
+    if (tail.getSkippedRecords() > 0) {
+        std::cout << "Warning: " << tail.getSkippedRecords() << " unreadable rows were skipped." << std::endl;
+    }
+}
+
+// Matches with low <= ID <= high, in ID order
+void MatchHistory::findMatchesInRange(int low, int high, std::vector<const Match*>& found) const {
+    found.clear();
+    for (OrderedIDIndex::Cursor cursor = orderedIDs.seek(low); cursor.isValid() && cursor.matchID() <= high; cursor.next()) {
+        found.push_back(&matchStack.at(cursor.position()));
+    }
+}
+
+// Up to count matches with IDs above afterID, in ID order
+int MatchHistory::readMatchesAfter(int afterID, int count, std::vector<const Match*>& page) const {
+    std::vector<int> positions;
+    int nextAfter = orderedIDs.readPage(afterID, count, positions);
+
+    page.clear();
+    for (int position : positions) {
+        page.push_back(&matchStack.at(position));
+    }
+    return nextAfter;
+}
+
+// Aggregated results of a player (exact name, any case), or nullptr if unknown
+const PlayerStats* MatchHistory::getPlayerStats(const std::string& playerName) const {
+    int nameID = nameIndex.findName(playerName);
+    if (nameID < 0) {
+        return nullptr;
+    }
+
+    refreshStreaks(nameID);
+    return playerStats.find(nameID);
+}
+
+// Rebuild a player's streak and form if a replaced record left them stale
+void MatchHistory::refreshStreaks(int nameID) const {
+    if (!playerStats.isStale(nameID)) {
+        return;
+    }
+
+    // Replay this player's own matches
+    std::vector<int> results;
+    for (int position : nameIndex.getPostings(nameID)) {
+        const Match& match = matchStack.at(position);
+        int side = nameIndex.findName(match.player1) == nameID ? 1 : 2;
+        int winner = winnerSide(match);
+        results.push_back(winner == 0 ? 0 : (winner == side ? 1 : -1));
+    }
+    playerStats.rebuildStreaks(nameID, results);
+}
+
+// The k best players by a metric, best first
+void MatchHistory::getLeaderboard(LeaderboardMetric metric, int k, std::vector<LeaderboardEntry>& top) const {
+    if (metric == LeaderboardMetric::LongestWinStreak && playerStats.hasStale()) {
+        for (int nameID = 0; nameID < playerStats.getSize(); nameID++) {
+            refreshStreaks(nameID);
+        }
+    }
+    leaderboard.refresh(playerStats);
+    leaderboard.getTop(metric, k, playerStats, top);
+}
+
+// Display the k best players by a metric
+void MatchHistory::viewLeaderboard(LeaderboardMetric metric, int k) const {
+    static const char* const titles[] = { "MOST WINS", "LONGEST WINNING STREAKS", "MOST MATCHES PLAYED" };
+    static const char* const units[] = { "wins", "wins in a row", "matches" };
+    int m = static_cast<int>(metric);
+
+    std::vector<LeaderboardEntry> top;
+    getLeaderboard(metric, k, top);
+    if (top.empty()) {
+        std::cout << "No decided matches in history." << std::endl;
+        return;
+    }
+
+    std::cout << "\n===== " << titles[m] << " =====" << std::endl;
+    for (size_t i = 0; i < top.size(); i++) {
+        std::cout << std::setw(3) << i + 1 << ". " << nameIndex.getName(top[i].nameID) << " - "
+                  << top[i].value << " " << units[m] << std::endl;
+    }
+}
+
+// Display a player's aggregated results
+void MatchHistory::viewPlayerStats(const std::string& playerName) const {
+    const PlayerStats* stats = getPlayerStats(playerName);
+    if (stats == nullptr) {
+        std::cout << "No matches found for " << playerName << std::endl;
+        suggestSimilarNames(playerName);
+        return;
+    }
+
+    const std::string& name = nameIndex.getName(nameIndex.findName(playerName));
+    std::cout << "\n===== STATISTICS FOR " << name << " =====" << std::endl;
+    std::cout << "Matches: " << stats->wins + stats->losses
+              << " (Wins: " << stats->wins << ", Losses: " << stats->losses << ")" << std::endl;
+    std::cout << "Sets won-lost: " << stats->setsWon << "-" << stats->setsLost << std::endl;
+    std::cout << "Games won-lost: " << stats->gamesWon << "-" << stats->gamesLost << std::endl;
+
+    std::cout << "Current streak: ";
+    if (stats->currentStreak > 0) {
+        std::cout << stats->currentStreak << " win(s)" << std::endl;
+    } else if (stats->currentStreak < 0) {
+        std::cout << -stats->currentStreak << " loss(es)" << std::endl;
+    } else {
+        std::cout << "none" << std::endl;
+    }
+    std::cout << "Longest winning streak: " << stats->longestWinStreak << std::endl;
+
+    std::cout << "Last " << stats->formLength << " results (most recent first):";
+    for (int i = 0; i < stats->formLength; i++) {
+        std::cout << ((stats->form >> i) & 1u ? " W" : " L");
+    }
+    std::cout << std::endl;
+}
+
+// Meetings between two players (exact names, any case), or nullptr if they never met
+const HeadToHeadRecord* MatchHistory::getHeadToHead(const std::string& playerA, const std::string& playerB) const {
+    return headToHead.find(nameIndex.findName(playerA), nameIndex.findName(playerB));
+}
+
+// Display the head-to-head record of two players
+void MatchHistory::viewHeadToHead(const std::string& playerA, const std::string& playerB) const {
+    int idA = nameIndex.findName(playerA);
+    int idB = nameIndex.findName(playerB);
+    if (idA < 0 || idB < 0) {
+        std::cout << "No matches found for " << (idA < 0 ? playerA : playerB) << std::endl;
+        return;
+    }
+
+    const HeadToHeadRecord* record = headToHead.find(idA, idB);
+    const std::string& nameA = nameIndex.getName(idA);
+    const std::string& nameB = nameIndex.getName(idB);
+    if (record == nullptr) {
+        std::cout << nameA << " and " << nameB << " have never played each other." << std::endl;
+        return;
+    }
+
+    std::cout << "\n===== " << nameA << " VS " << nameB << " =====" << std::endl;
+    std::cout << "Meetings: " << record->getMeetings() << std::endl;
+    std::cout << nameA << " wins: " << record->getWins(idA) << std::endl;
+    std::cout << nameB << " wins: " << record->getWins(idB) << std::endl;
+
+    // Their matches, most recent first
+    std::cout << "\nMatches (most recent first):" << std::endl;
+    for (auto it = record->positions.rbegin(); it != record->positions.rend(); ++it) {
+        matchStack.at(*it).displayMatch();
+    }
+}
+
+// Display every opponent a player has met, with their record against each
+void MatchHistory::viewRivals(const std::string& playerName) const {
+    int nameID = nameIndex.findName(playerName);
+    std::vector<const HeadToHeadRecord*> rivalries;
+    headToHead.findRivalries(nameID, rivalries);
+    if (rivalries.empty()) {
+        std::cout << "No matches found for " << playerName << std::endl;
+        return;
+    }
+
+    // Most frequent opponents first
+    std::stable_sort(rivalries.begin(), rivalries.end(), [](const HeadToHeadRecord* a, const HeadToHeadRecord* b) {
+        return a->getMeetings() > b->getMeetings();
+    });
+
+    std::cout << "\n===== OPPONENTS OF " << nameIndex.getName(nameID) << " =====" << std::endl;
+    for (const HeadToHeadRecord* record : rivalries) {
+        int rivalID = record->lowID == nameID ? record->highID : record->lowID;
+        std::cout << nameIndex.getName(rivalID) << ": " << record->getMeetings() << " meeting(s), "
+                  << record->getWins(nameID) << "-" << record->getWins(rivalID) << std::endl;
+    }
+    std::cout << rivalries.size() << " opponents found." << std::endl;
+}
+
+// Parsed score of the match stored at a position (0 = oldest)
+MatchScore MatchHistory::getScoreAt(int position) const {
+    return MatchScore(packedScores.at(position));
+}
+
+// Totals over every readable score in the history
+ScoreSummary MatchHistory::summarizeAllScores() const {
+    return summarizeScores(packedScores.data(), packedScores.size());
+}
+
+// Display straight-set, tiebreak and game totals for the whole history
+void MatchHistory::viewScoreAnalytics() const {
+    ScoreSummary summary = summarizeAllScores();
+    long long unreadable = matchStack.getSize() - summary.scoredMatches;
+
+    std::cout << "\n===== SCORE ANALYTICS =====" << std::endl;
+    std::cout << "Matches with a readable score: " << summary.scoredMatches;
+    if (unreadable > 0) {
+        std::cout << " (" << unreadable << " unreadable)";
+    }
+    std::cout << std::endl;
+    if (summary.scoredMatches == 0) {
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Straight-set wins: " << summary.straightSetMatches << " ("
+              << 100.0 * summary.straightSetMatches / summary.scoredMatches << "%)" << std::endl;
+    if (summary.gameScoredMatches > 0) {
+        std::cout << "Matches with game scores: " << summary.gameScoredMatches << std::endl;
+        std::cout << "Sets played: " << summary.sets << ", decided by tiebreak: " << summary.tiebreakSets << " ("
+                  << 100.0 * summary.tiebreakSets / summary.sets << "%)" << std::endl;
+        std::cout << "Matches with a tiebreak: " << summary.tiebreakMatches << " ("
+                  << 100.0 * summary.tiebreakMatches / summary.gameScoredMatches << "%)" << std::endl;
+        std::cout << "Games played: " << summary.games << " (average "
+                  << static_cast<double>(summary.games) / summary.gameScoredMatches << " per match)" << std::endl;
+    }
+    std::cout << std::defaultfloat;
+}
+
+// Display one archived match in the same form as Match::displayMatch
+void displayArchiveRecord(const ArchiveRecord& record) {
+    Match(record.matchID, std::string(record.player1), std::string(record.player2),
+          std::string(record.winner), record.scoreText()).displayMatch();
+}
+
+// Look up matches in an archive file without loading it, or load it
+void searchArchive(MatchHistory& history, const std::string& archivePath) {
+    MatchArchiveReader reader;
+    std::string error;
+    if (!reader.open(archivePath, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    std::cout << archivePath << ": " << reader.getMatchCount() << " matches in "
+              << reader.getBlockCount() << " blocks." << std::endl;
+
+    std::cout << "1. Find Match by ID" << std::endl;
+    std::cout << "2. Find Matches by Player" << std::endl;
+    std::cout << "3. Load Archive into History" << std::endl;
+    std::cout << "Enter your choice: ";
+    int choice = getIntInput("", [](int c) { return c >= 1 && c <= 3; });
+
+    if (choice == 1) {
+        int matchID = getIntInput("Enter match ID to search: ", isValidMatchID);
+        ArchiveRecord record;
+        if (reader.findMatch(matchID, record)) {
+            displayArchiveRecord(record);
+        } else {
+            std::cout << "No match found with ID " << matchID << std::endl;
+        }
+    } else if (choice == 2) {
+        std::string playerName = getStringInput("Enter player name: ", [](const std::string& s) {
+            return !s.empty();
+        });
+        std::vector<ArchiveRecord> found;
+        int blocksRead = reader.findMatchesByPlayer(playerName, found);
+        for (const ArchiveRecord& record : found) {
+            displayArchiveRecord(record);
+        }
+        if (found.empty()) {
+            std::cout << "No matches found for " << playerName << std::endl;
+        } else {
+            std::cout << found.size() << " matches found (" << blocksRead << " of "
+                      << reader.getBlockCount() << " blocks read)." << std::endl;
+        }
+    } else {
+        if (history.getTotalMatches() > 0) {
+            char confirm;
+            std::cout << "Warning: This will replace the current match history ("
+                      << history.getTotalMatches() << " matches)." << std::endl;
+            std::cout << "Do you want to continue? (y/n): ";
+            std::cin >> confirm;
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+            if (confirm != 'y' && confirm != 'Y') {
+                std::cout << "Load operation cancelled." << std::endl;
+                return;
+            }
+        }
+        history.loadArchive(archivePath);
+    }
+}
+
+// Print the counts and issues of an import
+void displayImportReport(const ImportReport& report) {
+    for (const ImportIssue& issue : report.issues) {
+        std::cout << "Match " << issue.index + 1 << " (ID " << issue.matchID << "): " << issue.message << std::endl;
+    }
+    if (report.aborted) {
+        std::cout << "Import cancelled; no matches were added." << std::endl;
+        return;
+    }
+    std::cout << "Added " << report.added << ", replaced " << report.replaced << ", skipped "
+              << report.skipped << ", rejected " << report.rejected << "." << std::endl;
+}
+
+// Read every valid row of a history file, warning about bad rows
+bool readHistoryRows(const std::string& path, std::vector<Match>& matches) {
+    MappedFile inFile;
+    if (!inFile.open(path)) {
+        std::cout << "Error: Could not open file for reading: " << path << std::endl;
+        return false;
+    }
+
+    std::string_view text = inFile.view();
+    if (text.empty() || !isMatchHistoryHeader(takeLine(text))) {
+        std::cout << "Error: " << path << " is not a match history file." << std::endl;
+        return false;
+    }
+
+    std::vector<ParseError> errors;
+    parseMatchRecords(text, 2, [&](const MatchRecordView& record, int) {
+        matches.emplace_back(record.matchID, std::string(record.player1), std::string(record.player2),
+                             std::string(record.winner), std::string(record.score));
+    }, errors);
+    for (const ParseError& error : errors) {
+        std::cout << "Warning: " << error.message << " at line " << error.line << ", skipping this match." << std::endl;
+    }
+    return true;
+}
+
 // Function to run the match history subsystem
 void runMatchHistorySystem(MatchHistory& history) {
     int choice;
@@ -648,11 +1505,24 @@ void runMatchHistorySystem(MatchHistory& history) {
         std::cout << "5. Save Match History to File" << std::endl;
         std::cout << "6. Load Match History from File" << std::endl;
         std::cout << "7. Display Total Matches" << std::endl;
+        std::cout << "8. Compact Match History Journal" << std::endl;
+        std::cout << "9. Write Binary Snapshot of the Loaded File" << std::endl;
+        std::cout << "10. Browse Latest Matches in a File (without loading it)" << std::endl;
+        std::cout << "11. View Player Statistics" << std::endl;
+        std::cout << "12. View Head-to-Head Record" << std::endl;
+        std::cout << "13. View All Opponents of a Player" << std::endl;
+        std::cout << "14. View Score Analytics" << std::endl;
+        std::cout << "15. Browse Matches by ID Range" << std::endl;
+        std::cout << "16. Archive Match History" << std::endl;
+        std::cout << "17. Search or Load an Archive" << std::endl;
+        std::cout << "18. Import Matches from Another File" << std::endl;
+        std::cout << "19. View Leaderboards" << std::endl;
+        std::cout << "20. Export Matches (CSV / JSON Lines)" << std::endl;
         std::cout << "0. Return to Main Menu" << std::endl;
         std::cout << "Enter your choice: ";
 
         // Get menu choice with validation
-        choice = getIntInput("", [](int c) { return c >= 0 && c <= 7; });
+        choice = getIntInput("", [](int c) { return c >= 0 && c <= 20; });
 
         switch (choice) {
             case 1: { // Add New Match
@@ -823,7 +1693,13 @@ void runMatchHistorySystem(MatchHistory& history) {
                 }
 
                 std::string filename = getStringInput("Enter filename to save (e.g., match_history.txt): ", isValidFilename);
-                history.saveToFile(filename);
+
+                char sortByID;
+                std::cout << "Save in match ID order instead of the order matches were recorded? (y/n): ";
+                std::cin >> sortByID;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+                history.saveToFile(filename, (sortByID == 'y' || sortByID == 'Y') ? SaveOrder::ByMatchID : SaveOrder::OldestFirst);
                 break;
             }
 
@@ -853,12 +1729,216 @@ void runMatchHistorySystem(MatchHistory& history) {
                 std::cout << "Total matches in history: " << history.getTotalMatches() << std::endl;
                 break;
             }
+            case 8: { // Compact Match History Journal
+                std::cout << "\n----- Compact Match History Journal -----" << std::endl;
+                history.compactJournal();
+                break;
+            }
+            case 9: { // Write Binary Snapshot
+                std::cout << "\n----- Write Binary Snapshot -----" << std::endl;
+                history.saveSnapshot();
+                break;
+            }
+            case 10: { // Browse Latest Matches in a File
+                std::cout << "\n----- Browse Latest Matches in a File -----" << std::endl;
+
+                std::string filename = getStringInput("Enter history filename to browse (e.g., match_history.txt): ", isValidFilename);
+                browseLatestMatches("data/" + filename);
+                break;
+            }
+            case 11: { // View Player Statistics
+                std::cout << "\n----- View Player Statistics -----" << std::endl;
+
+                if (history.getTotalMatches() == 0) {
+                    std::cout << "No matches in history." << std::endl;
+                } else {
+                    std::string playerName = getStringInput("Enter player name: ", [](const std::string& s) {
+                        return !s.empty();
+                    });
+                    history.viewPlayerStats(playerName);
+                }
+                break;
+            }
+            case 12: { // View Head-to-Head Record
+                std::cout << "\n----- View Head-to-Head Record -----" << std::endl;
+
+                if (history.getTotalMatches() == 0) {
+                    std::cout << "No matches in history." << std::endl;
+                } else {
+                    auto notEmpty = [](const std::string& s) { return !s.empty(); };
+                    std::string playerA = getStringInput("Enter first player name: ", notEmpty);
+                    std::string playerB = getStringInput("Enter second player name: ", notEmpty);
+                    history.viewHeadToHead(playerA, playerB);
+                }
+                break;
+            }
+            case 13: { // View All Opponents of a Player
+                std::cout << "\n----- View All Opponents of a Player -----" << std::endl;
+
+                if (history.getTotalMatches() == 0) {
+                    std::cout << "No matches in history." << std::endl;
+                } else {
+                    std::string playerName = getStringInput("Enter player name: ", [](const std::string& s) {
+                        return !s.empty();
+                    });
+                    history.viewRivals(playerName);
+                }
+                break;
+            }
+            case 14: { // View Score Analytics
+                std::cout << "\n----- View Score Analytics -----" << std::endl;
+
+                if (history.getTotalMatches() == 0) {
+                    std::cout << "No matches in history." << std::endl;
+                } else {
+                    history.viewScoreAnalytics();
+                }
+                break;
+            }
+            case 15: { // Browse Matches by ID Range
+                std::cout << "\n----- Browse Matches by ID Range -----" << std::endl;
+
+                if (history.getTotalMatches() == 0) {
+                    std::cout << "No matches in history." << std::endl;
+                    break;
+                }
+
+                int low = getIntInput("Enter lowest match ID: ", isValidMatchID);
+                int high = getIntInput("Enter highest match ID: ", isValidMatchID);
+                if (high < low) {
+                    std::cout << "Error: Highest match ID must not be below the lowest." << std::endl;
+                    break;
+                }
+                int pageSize = getIntInput("Enter number of matches per page: ", [](int n) { return n > 0; });
+
+                std::cout << "\n===== MATCHES WITH IDS " << low << " TO " << high << " =====" << std::endl;
+
+                // Each page resumes after the last ID shown
+                std::vector<const Match*> page;
+                int afterID = low - 1;
+                int displayed = 0;
+                while (true) {
+                    afterID = history.readMatchesAfter(afterID, pageSize, page);
+
+                    bool pastRange = false;
+                    for (const Match* match : page) {
+                        if (match->matchID > high) {
+                            pastRange = true;
+                            break;
+                        }
+                        match->displayMatch();
+                        displayed++;
+                    }
+                    if (pastRange || static_cast<int>(page.size()) < pageSize || afterID >= high) {
+                        break;
+                    }
+
+                    char more;
+                    std::cout << "Show next page? (y/n): ";
+                    std::cin >> more;
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    if (more != 'y' && more != 'Y') {
+                        break;
+                    }
+                }
+
+                if (displayed == 0) {
+                    std::cout << "No matches found in that range." << std::endl;
+                } else {
+                    std::cout << displayed << " matches displayed." << std::endl;
+                }
+                break;
+            }
+            case 16: { // Archive Match History
+                std::cout << "\n----- Archive Match History -----" << std::endl;
+
+                std::string filename = getStringInput("Enter archive filename (e.g., season_2024.tcma): ", isValidFilename);
+                if (history.saveArchive("data/" + filename)) {
+                    std::cout << history.getTotalMatches() << " matches archived to data/" << filename << "." << std::endl;
+                } else {
+                    std::cout << "Error: Could not write data/" << filename << "." << std::endl;
+                }
+                break;
+            }
+            case 17: { // Search or Load an Archive
+                std::cout << "\n----- Search or Load an Archive -----" << std::endl;
+
+                std::string filename = getStringInput("Enter archive filename (e.g., season_2024.tcma): ", isValidFilename);
+                searchArchive(history, "data/" + filename);
+                break;
+            }
+            case 18: { // Import Matches from Another File
+                std::cout << "\n----- Import Matches from Another File -----" << std::endl;
+
+                std::string filename = getStringInput("Enter filename to import (e.g., other_tournament.txt): ", isValidFilename);
+                std::vector<Match> matches;
+                if (!readHistoryRows("data/" + filename, matches)) {
+                    break;
+                }
+                std::cout << matches.size() << " matches read from data/" << filename << "." << std::endl;
+
+                std::cout << "If a match ID is already in the history:" << std::endl;
+                std::cout << "1. Keep the existing match" << std::endl;
+                std::cout << "2. Replace it with the imported match" << std::endl;
+                std::cout << "3. Cancel the whole import" << std::endl;
+                std::cout << "Enter your choice: ";
+                int policyChoice = getIntInput("", [](int c) { return c >= 1 && c <= 3; });
+                ConflictPolicy policy = policyChoice == 1 ? ConflictPolicy::Skip
+                                      : policyChoice == 2 ? ConflictPolicy::Replace
+                                                          : ConflictPolicy::FailFast;
+
+                displayImportReport(history.addMatches(std::move(matches), policy));
+                break;
+            }
+            case 19: { // View Leaderboards
+                std::cout << "\n----- View Leaderboards -----" << std::endl;
+                std::cout << "1. Most Wins" << std::endl;
+                std::cout << "2. Longest Winning Streaks" << std::endl;
+                std::cout << "3. Most Matches Played" << std::endl;
+                std::cout << "Enter your choice: ";
+                int board = getIntInput("", [](int c) { return c >= 1 && c <= 3; });
+                int count = getIntInput("Enter number of players to show (1-100): ", [](int c) {
+                    return c >= 1 && c <= 100;
+                });
+
+                LeaderboardMetric metric = board == 1 ? LeaderboardMetric::Wins
+                                         : board == 2 ? LeaderboardMetric::LongestWinStreak
+                                                      : LeaderboardMetric::MatchesPlayed;
+                history.viewLeaderboard(metric, count);
+                break;
+            }
+            case 20: { // Export Matches
+                std::cout << "\n----- Export Matches -----" << std::endl;
+                std::cout << "1. CSV" << std::endl;
+                std::cout << "2. JSON Lines" << std::endl;
+                std::cout << "Enter your choice: ";
+                ExportFormat format = getIntInput("", [](int c) { return c >= 1 && c <= 2; }) == 1
+                                    ? ExportFormat::CSV : ExportFormat::JSONLines;
+                std::string filename = getStringInput("Enter export filename (e.g., matches.csv): ", isValidFilename);
+
+                ExportFilter filter;
+                filter.player = getStringInput("Only matches of player (leave blank for all): ");
+                char byRange;
+                std::cout << "Limit to a match ID range? (y/n): ";
+                std::cin >> byRange;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                if (byRange == 'y' || byRange == 'Y') {
+                    filter.minID = getIntInput("Enter lowest match ID: ", isValidMatchID);
+                    filter.maxID = getIntInput("Enter highest match ID: ", isValidMatchID);
+                }
+
+                long long written = history.exportMatches("data/" + filename, format, filter);
+                if (written >= 0) {
+                    std::cout << written << " matches exported to data/" << filename << "." << std::endl;
+                }
+                break;
+            }
             case 0: // Return to Main Menu
                 running = false;
                 std::cout << "Returning to Main Menu..." << std::endl;
                 break;
             default:
-                std::cout << "Invalid choice. Please enter a number between 0 and 7." << std::endl;
+                std::cout << "Invalid choice. Please enter a number between 0 and 20." << std::endl;
         }
     }
 }
\ No newline at end of file
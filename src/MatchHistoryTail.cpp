@@ -0,0 +1,174 @@
+// MatchHistoryTail.cpp
+#include "../include/MatchHistoryTail.h"
+#include "../include/MatchJournal.h"
+#include "../include/MatchRecordParser.h"
+#include <algorithm>
+
+// Constructor
+BackwardLineReader::BackwardLineReader() : unreadBytes(0) {}
+
+// Open a file and position the reader at its end
+bool BackwardLineReader::open(const std::string& path) {
+    close();
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.seekg(0, std::ios::end);
+    unreadBytes = file.tellg();
+    if (unreadBytes < 0) {
+        close();
+        return false;
+    }
+
+    // A newline at the very end terminates the last line rather than
+    // starting an empty one
+    if (unreadBytes > 0) {
+        file.seekg(unreadBytes - 1);
+        if (file.get() == '\n') {
+            unreadBytes--;
+        }
+    }
+    buffer.clear();
+    return true;
+}
+
+// Close the file
+void BackwardLineReader::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    unreadBytes = 0;
+    buffer.clear();
+}
+
+// Check whether a file is open
+bool BackwardLineReader::isOpen() const {
+    return file.is_open();
+}
+
+// Read the line before the previous one (without its newline)
+bool BackwardLineReader::previousLine(std::string& line) {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    while (true) {
+        size_t newline = buffer.rfind('\n');
+        if (newline != std::string::npos) {
+            line.assign(buffer, newline + 1, std::string::npos);
+            buffer.resize(newline);
+            break;
+        }
+
+        if (unreadBytes == 0) {
+            // Whatever is left is the first line of the file
+            line.swap(buffer);
+            buffer.clear();
+            file.close();
+            break;
+        }
+
+        // Pull in the block before the buffered bytes
+        std::streamoff blockSize = std::min<std::streamoff>(BLOCK_SIZE, unreadBytes);
+        unreadBytes -= blockSize;
+        std::string block(static_cast<size_t>(blockSize), '\0');
+        file.seekg(unreadBytes);
+        file.read(&block[0], blockSize);
+        if (file.gcount() != blockSize) {
+            close();
+            return false;
+        }
+        buffer.insert(0, block);
+    }
+
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+// Check whether the line last returned was the first line of the file
+bool BackwardLineReader::atStart() const {
+    return !file.is_open();
+}
+
+// Constructor
+MatchHistoryTail::MatchHistoryTail() : skippedRecords(0) {}
+
+// Open a history file and its journal (if any) for reading from the end
+bool MatchHistoryTail::open(const std::string& basePath) {
+    close();
+    if (!baseReader.open(basePath)) {
+        return false;
+    }
+    journalReader.open(MatchJournal::journalPathFor(basePath)); // No journal is fine
+    return true;
+}
+
+// Close both files and forget the matches already returned
+void MatchHistoryTail::close() {
+    journalReader.close();
+    baseReader.close();
+    seenIDs.clear();
+    skippedRecords = 0;
+}
+
+// Parse the next usable record, newest first. Returns false at the end.
+bool MatchHistoryTail::nextRecord(Match& match) {
+    std::string line;
+    MatchRecordView record;
+
+    while (true) {
+        bool fromBase = false;
+        if (!journalReader.previousLine(line)) {
+            if (!baseReader.previousLine(line)) {
+                return false;
+            }
+            fromBase = true;
+        }
+
+        if (line.empty()) {
+            continue;
+        }
+        if (fromBase && baseReader.atStart() && isMatchHistoryHeader(line)) {
+            continue;
+        }
+        if (parseMatchRecord(line, record) != nullptr) {
+            skippedRecords++;
+            continue;
+        }
+
+        // An older record of an ID already seen has been superseded
+        if (seenIDs.contains(record.matchID)) {
+            continue;
+        }
+        seenIDs.insert(record.matchID, 0);
+
+        match = Match(record.matchID, std::string(record.player1), std::string(record.player2),
+                      std::string(record.winner), std::string(record.score));
+        return true;
+    }
+}
+
+// Read up to count older matches, most recent first
+int MatchHistoryTail::readPage(int count, std::vector<Match>& page) {
+    page.clear();
+    Match match;
+    while (static_cast<int>(page.size()) < count && nextRecord(match)) {
+        page.push_back(std::move(match));
+    }
+    return static_cast<int>(page.size());
+}
+
+// Check whether every record has been read
+bool MatchHistoryTail::atEnd() const {
+    return journalReader.atStart() && baseReader.atStart();
+}
+
+// Number of rows skipped because they could not be parsed
+int MatchHistoryTail::getSkippedRecords() const {
+    return skippedRecords;
+}
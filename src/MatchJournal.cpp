@@ -0,0 +1,197 @@
+// MatchJournal.cpp
+#include "../include/MatchJournal.h"
+#include "../include/MatchRecordParser.h"
+#include "../include/MappedFile.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Flush the C stream and ask the OS to write the file to disk
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Ask the OS to write the directory entry for path to disk
+bool syncDirectory(const std::string& path) {
+#ifdef _WIN32
+    // Directories cannot be opened for syncing; renames are durable once done
+    (void)path;
+    return true;
+#else
+    std::string::size_type slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int descriptor = ::open(directory.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool synced = fsync(descriptor) == 0;
+    ::close(descriptor);
+    return synced;
+#endif
+}
+
+// Constructor
+MatchJournal::MatchJournal()
+    : file(nullptr), policy(FsyncPolicy::EveryRecord), syncInterval(1), unsyncedRecords(0), recordCount(0) {
+}
+
+// Destructor
+MatchJournal::~MatchJournal() {
+    close();
+}
+
+// Journal file used for a given history file
+std::string MatchJournal::journalPathFor(const std::string& basePath) {
+    return basePath + ".journal";
+}
+
+// Open (or create) the journal for basePath
+bool MatchJournal::open(const std::string& path) {
+    close();
+
+    // Count the records already present so compaction thresholds carry over
+    int existingRecords = 0;
+    MappedFile existing;
+    if (existing.open(journalPathFor(path))) {
+        std::string_view text = existing.view();
+        existingRecords = static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+    }
+
+    std::FILE* opened = std::fopen(journalPathFor(path).c_str(), "ab");
+    if (opened == nullptr) {
+        return false;
+    }
+
+    file = opened;
+    basePath = path;
+    journalPath = journalPathFor(path);
+    recordCount = existingRecords;
+    unsyncedRecords = 0;
+    return true;
+}
+
+// Sync and close the journal
+void MatchJournal::close() {
+    if (file != nullptr) {
+        if (unsyncedRecords > 0 && policy != FsyncPolicy::Never) {
+            syncFile(file);
+        }
+        std::fclose(file);
+        file = nullptr;
+    }
+    unsyncedRecords = 0;
+    recordCount = 0;
+}
+
+// Check whether the journal is open
+bool MatchJournal::isOpen() const {
+    return file != nullptr;
+}
+
+// Choose when appended records are fsynced
+void MatchJournal::setFsyncPolicy(FsyncPolicy newPolicy, int interval) {
+    policy = newPolicy;
+    syncInterval = interval > 0 ? interval : 1;
+}
+
+// When appends are forced to disk
+FsyncPolicy MatchJournal::getFsyncPolicy() const {
+    return policy;
+}
+
+// Append one match record
+bool MatchJournal::append(const Match& match) {
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::string row;
+    appendMatchRecord(row, match);
+    if (std::fwrite(row.data(), 1, row.size(), file) != row.size() || std::fflush(file) != 0) {
+        return false;
+    }
+
+    recordCount++;
+    unsyncedRecords++;
+
+    if (policy == FsyncPolicy::EveryRecord ||
+        (policy == FsyncPolicy::EveryN && unsyncedRecords >= syncInterval)) {
+        return sync();
+    }
+    return true;
+}
+
+// Append several records with one write
+bool MatchJournal::appendBatch(const std::vector<const Match*>& matches) {
+    if (file == nullptr) {
+        return false;
+    }
+    if (matches.empty()) {
+        return true;
+    }
+
+    std::string rows;
+    for (const Match* match : matches) {
+        appendMatchRecord(rows, *match);
+    }
+    if (std::fwrite(rows.data(), 1, rows.size(), file) != rows.size() || std::fflush(file) != 0) {
+        return false;
+    }
+
+    recordCount += static_cast<int>(matches.size());
+    unsyncedRecords += static_cast<int>(matches.size());
+
+    if (policy == FsyncPolicy::EveryRecord ||
+        (policy == FsyncPolicy::EveryN && unsyncedRecords >= syncInterval)) {
+        return sync();
+    }
+    return true;
+}
+
+// Force appended records to stable storage
+bool MatchJournal::sync() {
+    if (file == nullptr) {
+        return false;
+    }
+    unsyncedRecords = 0;
+    return syncFile(file);
+}
+
+// Discard all records once they have been folded into the base file
+bool MatchJournal::reset() {
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::FILE* truncated = std::freopen(journalPath.c_str(), "wb", file);
+    if (truncated == nullptr) {
+        file = nullptr;
+        return false;
+    }
+    file = truncated;
+    recordCount = 0;
+    unsyncedRecords = 0;
+    return syncFile(file);
+}
+
+// Number of records in the journal
+int MatchJournal::getRecordCount() const {
+    return recordCount;
+}
+
+// History file this journal belongs to
+const std::string& MatchJournal::getBasePath() const {
+    return basePath;
+}
@@ -0,0 +1,125 @@
+// MatchRecordParser.cpp
+#include "../include/MatchRecordParser.h"
+#include <charconv>
+#include <cctype>
+
+namespace {
+
+// Reads comma-separated fields the same way std::getline does on a
+// stringstream: a field may be empty, but reading past the end fails.
+struct FieldCursor {
+    std::string_view rest;
+    bool exhausted;
+
+    explicit FieldCursor(std::string_view line) : rest(line), exhausted(line.empty()) {}
+
+    bool next(std::string_view& field) {
+        if (exhausted) return false;
+
+        size_t comma = rest.find(',');
+        if (comma == std::string_view::npos) {
+            field = rest;
+            rest = std::string_view();
+            exhausted = true;
+        } else {
+            field = rest.substr(0, comma);
+            rest = rest.substr(comma + 1);
+            exhausted = rest.empty();
+        }
+        return true;
+    }
+
+    bool remainder(std::string_view& field) {
+        if (exhausted) return false;
+        field = rest;
+        exhausted = true;
+        return true;
+    }
+};
+
+// Drop a single leading space, as written by saveToFile
+std::string_view stripLeadingSpace(std::string_view field) {
+    if (!field.empty() && field[0] == ' ') field.remove_prefix(1);
+    return field;
+}
+
+// Parse a positive match ID, accepting the same input std::stoi does
+bool parseMatchID(std::string_view field, int& id) {
+    size_t i = 0;
+    while (i < field.size() && std::isspace(static_cast<unsigned char>(field[i]))) i++;
+    if (i < field.size() && field[i] == '+') i++;
+
+    const char* first = field.data() + i;
+    const char* last = field.data() + field.size();
+    auto result = std::from_chars(first, last, id);
+    return result.ec == std::errc() && id > 0;
+}
+
+}
+
+// Check that a header line names all five match history columns
+bool isMatchHistoryHeader(std::string_view line) {
+    return line.find("MatchID") != std::string_view::npos &&
+           line.find("Player1") != std::string_view::npos &&
+           line.find("Player2") != std::string_view::npos &&
+           line.find("Winner") != std::string_view::npos &&
+           line.find("Score") != std::string_view::npos;
+}
+
+// Append a match as one row in the history file format (notice spaces after commas)
+void appendMatchRecord(std::string& out, const Match& match) {
+    appendMatchRecord(out, match.matchID, match.player1, match.player2, match.winner, match.score);
+}
+
+void appendMatchRecord(std::string& out, int matchID, std::string_view player1, std::string_view player2,
+                       std::string_view winner, std::string_view score) {
+    char id[16];
+    auto result = std::to_chars(id, id + sizeof(id), matchID);
+    out.append(id, result.ptr);
+    out += ", ";
+    out += player1;
+    out += ", ";
+    out += player2;
+    out += ", ";
+    out += winner;
+    out += ", ";
+    out += score;
+    out += '\n';
+}
+
+// Parse one data row
+const char* parseMatchRecord(std::string_view line, MatchRecordView& record) {
+    FieldCursor cursor(line);
+    std::string_view field;
+
+    // Parse matchID
+    if (!cursor.next(field)) return "Failed to parse Match ID.";
+    if (!parseMatchID(field, record.matchID)) return "Invalid Match ID format";
+
+    // Parse player1
+    if (!cursor.next(field)) return "Failed to parse Player 1 name.";
+    record.player1 = stripLeadingSpace(field);
+    if (record.player1.empty()) return "Player 1 name is empty.";
+
+    // Parse player2
+    if (!cursor.next(field)) return "Failed to parse Player 2 name.";
+    record.player2 = stripLeadingSpace(field);
+    if (record.player2.empty()) return "Player 2 name is empty.";
+
+    // Parse winner
+    if (!cursor.next(field)) return "Failed to parse Winner name.";
+    record.winner = stripLeadingSpace(field);
+    if (record.winner.empty()) return "Winner name is empty.";
+
+    // Parse score (rest of the line)
+    if (!cursor.remainder(field)) return "Failed to parse Score.";
+    record.score = stripLeadingSpace(field);
+    if (record.score.empty()) return "Score is empty.";
+
+    // Validate that winner is one of the players
+    if (record.winner != record.player1 && record.winner != record.player2) {
+        return "Winner must be one of the players.";
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,203 @@
+// MatchScore.cpp
+#include "../include/MatchScore.h"
+#include <cctype>
+#include <utility>
+#include <bit>
+
+namespace {
+
+// Read an unsigned number of at most two digits; false if there is none
+bool readNumber(std::string_view text, size_t& i, int& value) {
+    size_t start = i;
+    value = 0;
+    while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) {
+        if (i - start == 2) return false;
+        value = value * 10 + (text[i++] - '0');
+    }
+    return i > start;
+}
+
+}
+
+// Read a score
+MatchScore MatchScore::parse(std::string_view score, int winnerSide) {
+    int first[MAX_SETS], second[MAX_SETS];
+    bool tiebreak[MAX_SETS];
+    int pairs = 0;
+
+    size_t i = 0;
+    while (i < score.size()) {
+        if (std::isspace(static_cast<unsigned char>(score[i]))) {
+            i++;
+            continue;
+        }
+        if (pairs == MAX_SETS) return MatchScore();
+
+        int a, b;
+        if (!readNumber(score, i, a) || i >= score.size() || score[i] != '-') return MatchScore();
+        i++;
+        if (!readNumber(score, i, b)) return MatchScore();
+
+        // Optional tiebreak points, e.g. "7-6(5)"
+        bool sawTiebreak = false;
+        if (i < score.size() && score[i] == '(') {
+            int points;
+            i++;
+            if (!readNumber(score, i, points) || i >= score.size() || score[i] != ')') return MatchScore();
+            i++;
+            sawTiebreak = true;
+        }
+        if (i < score.size() && !std::isspace(static_cast<unsigned char>(score[i]))) return MatchScore();
+
+        first[pairs] = a;
+        second[pairs] = b;
+        tiebreak[pairs] = sawTiebreak || (a == 7 && b == 6) || (a == 6 && b == 7);
+        pairs++;
+    }
+    if (pairs == 0) return MatchScore();
+
+    // A lone pair too small to be a set is a set count
+    Kind kind = (pairs == 1 && first[0] <= 3 && second[0] <= 3) ? SetsOnly : Games;
+
+    // Some scores are written from the winner's side
+    int setsFirst = 0, setsSecond = 0;
+    if (kind == SetsOnly) {
+        setsFirst = first[0];
+        setsSecond = second[0];
+    } else {
+        for (int set = 0; set < pairs; set++) {
+            if (first[set] > second[set]) setsFirst++;
+            else if (second[set] > first[set]) setsSecond++;
+        }
+    }
+    if ((winnerSide == 1 && setsFirst < setsSecond) || (winnerSide == 2 && setsSecond < setsFirst)) {
+        for (int set = 0; set < pairs; set++) std::swap(first[set], second[set]);
+    }
+
+    uint64_t packed = static_cast<uint64_t>(kind) << KIND_SHIFT;
+    for (int set = 0; set < pairs; set++) {
+        if (first[set] > 15 || second[set] > 15) return MatchScore();
+        packed |= static_cast<uint64_t>(first[set] | (second[set] << 4)) << (set * 8);
+        if (kind == Games && tiebreak[set]) packed |= uint64_t(1) << (TIEBREAK_SHIFT + set);
+    }
+    if (kind == Games) {
+        packed |= static_cast<uint64_t>(pairs) << COUNT_SHIFT;
+    }
+    return MatchScore(packed);
+}
+
+// Build a score from packed set bytes
+MatchScore MatchScore::fromSets(Kind kind, const uint8_t* sets, int setCount) {
+    if (kind == Unknown || setCount < 1 || setCount > MAX_SETS || (kind == SetsOnly && setCount != 1)) {
+        return MatchScore();
+    }
+
+    uint64_t packed = static_cast<uint64_t>(kind) << KIND_SHIFT;
+    for (int set = 0; set < setCount; set++) {
+        packed |= static_cast<uint64_t>(sets[set]) << (set * 8);
+        int a = sets[set] & 15;
+        int b = sets[set] >> 4;
+        if (kind == Games && ((a == 7 && b == 6) || (a == 6 && b == 7))) {
+            packed |= uint64_t(1) << (TIEBREAK_SHIFT + set);
+        }
+    }
+    if (kind == Games) {
+        packed |= static_cast<uint64_t>(setCount) << COUNT_SHIFT;
+    }
+    return MatchScore(packed);
+}
+
+// Number of sets decided by a tiebreak
+int MatchScore::getTiebreakCount() const {
+    return std::popcount((bits >> TIEBREAK_SHIFT) & 31u);
+}
+
+// Sets won by player 1 (side 1) or player 2 (side 2)
+int MatchScore::getSetsWon(int side) const {
+    if (getKind() == SetsOnly) {
+        return getGames(0, side);
+    }
+    int other = side == 1 ? 2 : 1;
+    int won = 0;
+    for (int set = 0; set < getSetCount(); set++) {
+        if (getGames(set, side) > getGames(set, other)) won++;
+    }
+    return won;
+}
+
+// Games won by player 1 (side 1) or player 2 (side 2); 0 unless Games
+int MatchScore::getGamesWon(int side) const {
+    int won = 0;
+    for (int set = 0; set < getSetCount(); set++) {
+        won += getGames(set, side);
+    }
+    return won;
+}
+
+// Check whether the loser did not win a set
+bool MatchScore::isStraightSets() const {
+    if (getKind() == Unknown) {
+        return false;
+    }
+    int won1 = getSetsWon(1);
+    int won2 = getSetsWon(2);
+    return won1 != won2 && (won1 == 0 || won2 == 0);
+}
+
+// Score written out in the usual form, e.g. "6-4 7-6" or "2-1"
+std::string MatchScore::toString() const {
+    std::string text;
+    int sets = getKind() == SetsOnly ? 1 : getSetCount();
+    for (int set = 0; set < sets; set++) {
+        if (set > 0) text += ' ';
+        text += std::to_string(getGames(set, 1));
+        text += '-';
+        text += std::to_string(getGames(set, 2));
+    }
+    return text;
+}
+
+// Aggregate a column of packed scores. Each word is read with mask and
+// popcount arithmetic, with no branch per score: an Unknown score is all
+// zero bits, and set bytes past the set count are zero, so neither adds
+// anything.
+ScoreSummary summarizeScores(const uint64_t* packed, size_t count) {
+    const uint64_t lowNibbles = 0x0F0F0F0F0FULL;  // Player 1 games, one byte per set
+    const uint64_t setTopBits = 0x8080808080ULL;
+    const uint64_t setOnes = 0x0101010101ULL;
+
+    ScoreSummary summary;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t bits = packed[i];
+        uint64_t kind = (bits >> MatchScore::KIND_SHIFT) & 3u;
+        uint64_t games = kind == MatchScore::Games;
+        uint64_t setsOnly = kind == MatchScore::SetsOnly;
+        uint64_t player1 = bits & lowNibbles;
+        uint64_t player2 = (bits >> 4) & lowNibbles;
+
+        // Top bit of a set byte is set where one side won more games than
+        // the other (no byte borrows: games are at most 15). Shifted down to
+        // one per byte, the multiply adds the bytes up in its top byte.
+        uint64_t player1Sets = (((((player1 | setTopBits) - player2 - setOnes) & setTopBits) >> 7) * setOnes >> 32) & 0xFF;
+        uint64_t player2Sets = (((((player2 | setTopBits) - player1 - setOnes) & setTopBits) >> 7) * setOnes >> 32) & 0xFF;
+        // A set count sits in the nibbles of the first byte instead
+        uint64_t won1 = games * player1Sets + setsOnly * (bits & 15u);
+        uint64_t won2 = games * player2Sets + setsOnly * ((bits >> 4) & 15u);
+
+        uint64_t gamesPlayed = (((player1 + player2) * setOnes) >> 32) & 0xFF;
+        // Popcount of the five tiebreak flags: a nibble table for four of
+        // them plus the fifth (std::popcount is a library call without
+        // hardware popcnt enabled)
+        uint64_t flags = (bits >> MatchScore::TIEBREAK_SHIFT) & 31u;
+        uint64_t tiebreaks = ((0x4332322132212110ULL >> ((flags & 15u) * 4)) & 15u) + (flags >> 4);
+
+        summary.scoredMatches += kind != MatchScore::Unknown;
+        summary.straightSetMatches += (won1 != won2) & ((won1 == 0) | (won2 == 0));
+        summary.gameScoredMatches += games;
+        summary.sets += games * ((bits >> MatchScore::COUNT_SHIFT) & 7u);
+        summary.tiebreakSets += tiebreaks;
+        summary.tiebreakMatches += tiebreaks > 0;
+        summary.games += games * gamesPlayed;
+    }
+    return summary;
+}
@@ -0,0 +1,334 @@
+// MatchSnapshot.cpp
+#include "../include/MatchSnapshot.h"
+#include "../include/MatchRecordParser.h"
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+
+namespace {
+
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+uint64_t alignTo8(uint64_t pos) {
+    return (pos + 7) & ~static_cast<uint64_t>(7);
+}
+
+// Write a section and pad the file up to the next 8-byte boundary
+void writeSection(std::ofstream& out, const void* data, uint64_t bytes, uint64_t& pos) {
+    static const char padding[8] = {};
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    uint64_t end = pos + bytes;
+    uint64_t aligned = alignTo8(end);
+    out.write(padding, static_cast<std::streamsize>(aligned - end));
+    pos = aligned;
+}
+
+// Offsets and concatenated bytes for a string dictionary
+void flattenDictionary(const std::vector<std::string>& entries, std::vector<uint32_t>& offsets, std::string& bytes) {
+    offsets.clear();
+    bytes.clear();
+    offsets.push_back(0);
+    for (const std::string& entry : entries) {
+        bytes += entry;
+        offsets.push_back(static_cast<uint32_t>(bytes.size()));
+    }
+}
+
+}
+
+// ===================== MatchSnapshotWriter =====================
+
+uint32_t MatchSnapshotWriter::encode(std::string_view value, std::unordered_map<std::string, uint32_t>& codes,
+                                     std::vector<std::string>& dictionary) {
+    std::string key(value);
+    auto it = codes.find(key);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    uint32_t code = static_cast<uint32_t>(dictionary.size());
+    codes.emplace(key, code);
+    dictionary.push_back(std::move(key));
+    return code;
+}
+
+// Add the next match (oldest first)
+void MatchSnapshotWriter::add(int matchID, std::string_view p1, std::string_view p2, std::string_view w, std::string_view s) {
+    ids.push_back(matchID);
+    player1.push_back(encode(p1, nameCodes, names));
+    player2.push_back(encode(p2, nameCodes, names));
+    winner.push_back(w == p1 ? 0 : 1);
+    score.push_back(encode(s, scoreCodes, scores));
+}
+
+// Number of matches added so far
+int MatchSnapshotWriter::getMatchCount() const {
+    return static_cast<int>(ids.size());
+}
+
+// Write the snapshot to path
+bool MatchSnapshotWriter::write(const std::string& path) const {
+    std::vector<uint32_t> nameOffsets, scoreOffsets;
+    std::string nameBytes, scoreBytes;
+    flattenDictionary(names, nameOffsets, nameBytes);
+    flattenDictionary(scores, scoreOffsets, scoreBytes);
+
+    uint32_t matchCount = static_cast<uint32_t>(ids.size());
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.matchCount = matchCount;
+    header.nameCount = static_cast<uint32_t>(names.size());
+    header.scoreCount = static_cast<uint32_t>(scores.size());
+
+    // Lay the sections out one after another
+    uint64_t pos = alignTo8(sizeof(SnapshotHeader));
+    header.nameOffsetsPos = pos;  pos = alignTo8(pos + nameOffsets.size() * sizeof(uint32_t));
+    header.nameBytesPos = pos;    pos = alignTo8(pos + nameBytes.size());
+    header.scoreOffsetsPos = pos; pos = alignTo8(pos + scoreOffsets.size() * sizeof(uint32_t));
+    header.scoreBytesPos = pos;   pos = alignTo8(pos + scoreBytes.size());
+    header.idsPos = pos;          pos = alignTo8(pos + matchCount * sizeof(int32_t));
+    header.player1Pos = pos;      pos = alignTo8(pos + matchCount * sizeof(uint32_t));
+    header.player2Pos = pos;      pos = alignTo8(pos + matchCount * sizeof(uint32_t));
+    header.winnerPos = pos;       pos = alignTo8(pos + matchCount * sizeof(uint8_t));
+    header.scorePos = pos;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    pos = 0;
+    writeSection(out, &header, sizeof(header), pos);
+    writeSection(out, nameOffsets.data(), nameOffsets.size() * sizeof(uint32_t), pos);
+    writeSection(out, nameBytes.data(), nameBytes.size(), pos);
+    writeSection(out, scoreOffsets.data(), scoreOffsets.size() * sizeof(uint32_t), pos);
+    writeSection(out, scoreBytes.data(), scoreBytes.size(), pos);
+    writeSection(out, ids.data(), matchCount * sizeof(int32_t), pos);
+    writeSection(out, player1.data(), matchCount * sizeof(uint32_t), pos);
+    writeSection(out, player2.data(), matchCount * sizeof(uint32_t), pos);
+    writeSection(out, winner.data(), matchCount * sizeof(uint8_t), pos);
+    writeSection(out, score.data(), matchCount * sizeof(uint32_t), pos);
+
+    out.close();
+    return !out.fail();
+}
+
+// ===================== MatchSnapshotReader =====================
+
+// Constructor
+MatchSnapshotReader::MatchSnapshotReader() {
+    std::memset(&header, 0, sizeof(header));
+}
+
+uint32_t MatchSnapshotReader::column32(uint64_t pos, uint32_t index) const {
+    uint32_t value;
+    std::memcpy(&value, file.data() + pos + static_cast<uint64_t>(index) * sizeof(uint32_t), sizeof(value));
+    return value;
+}
+
+std::string_view MatchSnapshotReader::dictionaryEntry(uint64_t offsetsPos, uint64_t bytesPos, uint32_t code) const {
+    uint32_t begin = column32(offsetsPos, code);
+    uint32_t end = column32(offsetsPos, code + 1);
+    return std::string_view(file.data() + bytesPos + begin, end - begin);
+}
+
+// Map and validate a snapshot
+bool MatchSnapshotReader::open(const std::string& path, std::string& error) {
+    if (!file.open(path)) {
+        error = "Could not open snapshot " + path;
+        return false;
+    }
+
+    uint64_t size = file.size();
+    if (size < sizeof(SnapshotHeader)) {
+        error = "Snapshot is truncated.";
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        error = "Not a match history snapshot.";
+        return false;
+    }
+    if (header.version != SNAPSHOT_VERSION) {
+        error = "Unsupported snapshot version " + std::to_string(header.version) + ".";
+        return false;
+    }
+    if (header.byteOrderMark != BYTE_ORDER_MARK) {
+        error = "Snapshot was written with a different byte order.";
+        return false;
+    }
+
+    // Every section must lie inside the file
+    uint64_t n = header.matchCount;
+    struct Section { uint64_t pos; uint64_t bytes; } sections[] = {
+        { header.nameOffsetsPos, (header.nameCount + 1ULL) * sizeof(uint32_t) },
+        { header.scoreOffsetsPos, (header.scoreCount + 1ULL) * sizeof(uint32_t) },
+        { header.idsPos, n * sizeof(int32_t) },
+        { header.player1Pos, n * sizeof(uint32_t) },
+        { header.player2Pos, n * sizeof(uint32_t) },
+        { header.winnerPos, n * sizeof(uint8_t) },
+        { header.scorePos, n * sizeof(uint32_t) },
+    };
+    for (const Section& section : sections) {
+        if (section.pos > size || section.bytes > size - section.pos) {
+            error = "Snapshot is truncated.";
+            return false;
+        }
+    }
+
+    // Dictionary offsets must be ordered and stay inside their byte sections
+    struct Dictionary { uint64_t offsetsPos; uint64_t bytesPos; uint32_t count; } dictionaries[] = {
+        { header.nameOffsetsPos, header.nameBytesPos, header.nameCount },
+        { header.scoreOffsetsPos, header.scoreBytesPos, header.scoreCount },
+    };
+    for (const Dictionary& dictionary : dictionaries) {
+        uint32_t previous = 0;
+        for (uint32_t i = 0; i <= dictionary.count; i++) {
+            uint32_t offset = column32(dictionary.offsetsPos, i);
+            if (offset < previous || dictionary.bytesPos + offset > size) {
+                error = "Snapshot dictionary is corrupt.";
+                return false;
+            }
+            previous = offset;
+        }
+    }
+
+    // Codes must refer to dictionary entries
+    for (uint32_t i = 0; i < header.matchCount; i++) {
+        if (column32(header.player1Pos, i) >= header.nameCount ||
+            column32(header.player2Pos, i) >= header.nameCount ||
+            column32(header.scorePos, i) >= header.scoreCount ||
+            static_cast<uint8_t>(file.data()[header.winnerPos + i]) > 1) {
+            error = "Snapshot column data is corrupt.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Number of matches in the snapshot
+int MatchSnapshotReader::getMatchCount() const {
+    return static_cast<int>(header.matchCount);
+}
+
+int MatchSnapshotReader::matchID(int index) const {
+    return static_cast<int>(column32(header.idsPos, static_cast<uint32_t>(index)));
+}
+
+std::string_view MatchSnapshotReader::player1(int index) const {
+    return dictionaryEntry(header.nameOffsetsPos, header.nameBytesPos, column32(header.player1Pos, static_cast<uint32_t>(index)));
+}
+
+std::string_view MatchSnapshotReader::player2(int index) const {
+    return dictionaryEntry(header.nameOffsetsPos, header.nameBytesPos, column32(header.player2Pos, static_cast<uint32_t>(index)));
+}
+
+std::string_view MatchSnapshotReader::winner(int index) const {
+    return file.data()[header.winnerPos + index] == 0 ? player1(index) : player2(index);
+}
+
+std::string_view MatchSnapshotReader::score(int index) const {
+    return dictionaryEntry(header.scoreOffsetsPos, header.scoreBytesPos, column32(header.scorePos, static_cast<uint32_t>(index)));
+}
+
+uint32_t MatchSnapshotReader::player1Code(int index) const {
+    return column32(header.player1Pos, static_cast<uint32_t>(index));
+}
+
+uint32_t MatchSnapshotReader::player2Code(int index) const {
+    return column32(header.player2Pos, static_cast<uint32_t>(index));
+}
+
+uint32_t MatchSnapshotReader::scoreCode(int index) const {
+    return column32(header.scorePos, static_cast<uint32_t>(index));
+}
+
+bool MatchSnapshotReader::player2Won(int index) const {
+    return file.data()[header.winnerPos + index] != 0;
+}
+
+int MatchSnapshotReader::getNameCount() const {
+    return static_cast<int>(header.nameCount);
+}
+
+int MatchSnapshotReader::getScoreCount() const {
+    return static_cast<int>(header.scoreCount);
+}
+
+std::string_view MatchSnapshotReader::nameEntry(uint32_t code) const {
+    return dictionaryEntry(header.nameOffsetsPos, header.nameBytesPos, code);
+}
+
+std::string_view MatchSnapshotReader::scoreEntry(uint32_t code) const {
+    return dictionaryEntry(header.scoreOffsetsPos, header.scoreBytesPos, code);
+}
+
+// ===================== Conversions =====================
+
+// Snapshot file used for a given history file
+std::string snapshotPathFor(const std::string& historyPath) {
+    return historyPath + ".snap";
+}
+
+// True if historyPath has a snapshot written after the text file was last changed
+bool isSnapshotCurrent(const std::string& historyPath) {
+    std::error_code ec;
+    auto snapshotTime = std::filesystem::last_write_time(snapshotPathFor(historyPath), ec);
+    if (ec) return false;
+    auto textTime = std::filesystem::last_write_time(historyPath, ec);
+    if (ec) return true; // Only the snapshot exists
+    return snapshotTime >= textTime;
+}
+
+// Convert a match_history.txt style file to a snapshot
+bool convertCsvToSnapshot(const std::string& csvPath, const std::string& snapshotPath) {
+    MappedFile csv;
+    if (!csv.open(csvPath)) {
+        return false;
+    }
+
+    std::string_view text = csv.view();
+    if (text.empty() || !isMatchHistoryHeader(takeLine(text))) {
+        return false;
+    }
+
+    MatchSnapshotWriter writer;
+    std::vector<ParseError> errors;
+    parseMatchRecords(text, 2, [&](const MatchRecordView& record, int) {
+        writer.add(record.matchID, record.player1, record.player2, record.winner, record.score);
+    }, errors);
+
+    return writer.write(snapshotPath);
+}
+
+// Convert a snapshot back to a match_history.txt style file
+bool convertSnapshotToCsv(const std::string& snapshotPath, const std::string& csvPath) {
+    MatchSnapshotReader reader;
+    std::string error;
+    if (!reader.open(snapshotPath, error)) {
+        return false;
+    }
+
+    std::ofstream out(csvPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    std::string buffer = MATCH_HISTORY_HEADER;
+    buffer += '\n';
+    for (int i = 0; i < reader.getMatchCount(); i++) {
+        appendMatchRecord(buffer, reader.matchID(i), reader.player1(i), reader.player2(i), reader.winner(i), reader.score(i));
+        if (buffer.size() >= (1 << 20)) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.close();
+    return !out.fail();
+}
@@ -0,0 +1,114 @@
+// OrderedIDIndex.cpp
+#include "../include/OrderedIDIndex.h"
+#include <algorithm>
+#include <climits>
+
+// Constructor
+OrderedIDIndex::OrderedIDIndex() : size(0) {}
+
+// Block that should hold matchID: the last block whose first ID is not above it
+int OrderedIDIndex::findBlock(int matchID) const {
+    int low = 0;
+    int high = static_cast<int>(blocks.size()) - 1;
+    while (low < high) {
+        int mid = (low + high + 1) / 2;
+        if (blocks[mid].ids.front() <= matchID) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
+
+// Add an ID, or update its position if already present
+void OrderedIDIndex::insert(int matchID, int position) {
+    if (blocks.empty()) {
+        blocks.emplace_back();
+    }
+
+    int b = findBlock(matchID);
+    Block* block = &blocks[b];
+    auto it = std::lower_bound(block->ids.begin(), block->ids.end(), matchID);
+    size_t offset = it - block->ids.begin();
+    if (it != block->ids.end() && *it == matchID) {
+        block->positions[offset] = position;
+        return;
+    }
+
+    // Split a full block, keeping both halves sorted
+    if (static_cast<int>(block->ids.size()) == BLOCK_SIZE) {
+        Block upper;
+        int half = BLOCK_SIZE / 2;
+        // Appending past the end: start a fresh block so sequential IDs fill blocks completely
+        if (b == static_cast<int>(blocks.size()) - 1 && offset == block->ids.size()) {
+            half = BLOCK_SIZE;
+        }
+        upper.ids.assign(block->ids.begin() + half, block->ids.end());
+        upper.positions.assign(block->positions.begin() + half, block->positions.end());
+        block->ids.resize(half);
+        block->positions.resize(half);
+        blocks.insert(blocks.begin() + b + 1, std::move(upper));
+
+        block = &blocks[b];
+        if (static_cast<int>(offset) >= half) {
+            block = &blocks[b + 1];
+            offset -= half;
+        }
+    }
+
+    block->ids.insert(block->ids.begin() + offset, matchID);
+    block->positions.insert(block->positions.begin() + offset, position);
+    size++;
+}
+
+// Cursor at the smallest ID
+OrderedIDIndex::Cursor OrderedIDIndex::first() const {
+    return Cursor(this, size == 0 ? static_cast<int>(blocks.size()) : 0, 0);
+}
+
+// Cursor at the smallest ID not below matchID
+OrderedIDIndex::Cursor OrderedIDIndex::seek(int matchID) const {
+    if (size == 0) {
+        return Cursor(this, static_cast<int>(blocks.size()), 0);
+    }
+
+    int b = findBlock(matchID);
+    const std::vector<int>& ids = blocks[b].ids;
+    int offset = static_cast<int>(std::lower_bound(ids.begin(), ids.end(), matchID) - ids.begin());
+    if (offset == static_cast<int>(ids.size())) {
+        return Cursor(this, b + 1, 0);
+    }
+    return Cursor(this, b, offset);
+}
+
+// Up to count positions of the matches with IDs above afterID, in ID order
+int OrderedIDIndex::readPage(int afterID, int count, std::vector<int>& positions) const {
+    positions.clear();
+    if (afterID == INT_MAX) {
+        return afterID;
+    }
+
+    int lastID = afterID;
+    for (Cursor cursor = seek(afterID + 1); cursor.isValid() && static_cast<int>(positions.size()) < count; cursor.next()) {
+        positions.push_back(cursor.position());
+        lastID = cursor.matchID();
+    }
+    return lastID;
+}
+
+// Largest ID stored, or 0 if empty
+int OrderedIDIndex::getMaxID() const {
+    return size == 0 ? 0 : blocks.back().ids.back();
+}
+
+// Remove every ID
+void OrderedIDIndex::clear() {
+    blocks.clear();
+    size = 0;
+}
+
+// Number of IDs stored
+int OrderedIDIndex::getSize() const {
+    return size;
+}
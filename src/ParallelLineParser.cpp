@@ -0,0 +1,74 @@
+// ParallelLineParser.cpp
+#include "../include/ParallelLineParser.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Below this many bytes per thread, starting a thread costs more than it saves
+const size_t MIN_CHUNK_BYTES = 4 << 20;
+
+}
+
+// Split off and return the first line of text (without the newline)
+std::string_view takeLine(std::string_view& text) {
+    size_t newline = text.find('\n');
+    std::string_view line;
+    if (newline == std::string_view::npos) {
+        line = text;
+        text = std::string_view();
+    } else {
+        line = text.substr(0, newline);
+        text.remove_prefix(newline + 1);
+    }
+    return line;
+}
+
+// Split text into at most `parts` consecutive, line-aligned pieces
+std::vector<std::string_view> splitOnLineBoundaries(std::string_view text, int parts) {
+    std::vector<std::string_view> chunks;
+    if (text.empty()) {
+        return chunks;
+    }
+    if (parts < 1) parts = 1;
+
+    size_t target = text.size() / static_cast<size_t>(parts) + 1;
+    size_t start = 0;
+
+    while (start < text.size()) {
+        size_t end = start + target;
+        if (end >= text.size() || static_cast<int>(chunks.size()) == parts - 1) {
+            end = text.size();
+        } else {
+            // Extend to the end of the line we landed in
+            size_t newline = text.find('\n', end);
+            end = newline == std::string_view::npos ? text.size() : newline + 1;
+        }
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+// Number of worker threads to use for parsing a buffer of the given size
+int chooseParseThreads(size_t bytes) {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+
+    if (const char* setting = std::getenv("TCMS_PARSE_THREADS")) {
+        int requested = std::atoi(setting);
+        if (requested > 0) threads = requested;
+    }
+    if (threads < 1) threads = 1;
+
+    size_t bySize = bytes / MIN_CHUNK_BYTES;
+    if (bySize < 1) bySize = 1;
+    return static_cast<int>(std::min(static_cast<size_t>(threads), bySize));
+}
+
+// Number of lines in a piece of text (a final line without '\n' counts)
+int countLines(std::string_view text) {
+    if (text.empty()) return 0;
+    int lines = static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+    if (text.back() != '\n') lines++;
+    return lines;
+}
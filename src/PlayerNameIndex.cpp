@@ -0,0 +1,336 @@
+// PlayerNameIndex.cpp
+#include "../include/PlayerNameIndex.h"
+#include "../include/FuzzyMatch.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <bit>
+
+// Lowercase a name for comparison
+std::string PlayerNameIndex::fold(const std::string& name) {
+    std::string folded = name;
+    for (char& c : folded) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return folded;
+}
+
+uint32_t PlayerNameIndex::packTrigram(const std::string& text, size_t start) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[start])) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(text[start + 1])) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(text[start + 2]));
+}
+
+// Distinct trigrams of "\1\1" + folded + "\2\2", packed
+void PlayerNameIndex::paddedTrigrams(const std::string& folded, std::vector<uint32_t>& grams) {
+    std::string padded = "\1\1" + folded + "\2\2";
+    grams.clear();
+    for (size_t i = 0; i + 3 <= padded.size(); i++) {
+        grams.push_back(packTrigram(padded, i));
+    }
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+}
+
+// Bit per letter present in a folded string
+uint32_t PlayerNameIndex::letterMask(const std::string& folded) {
+    uint32_t mask = 0;
+    for (char c : folded) {
+        mask |= (c >= 'a' && c <= 'z') ? 1u << (c - 'a') : 1u << 26;
+    }
+    return mask;
+}
+
+// Add a whole name or a word to the fuzzy search
+void PlayerNameIndex::addFuzzyEntry(const std::string& folded, int nameID, const std::string* token,
+                                    const std::vector<int>* names) {
+    int entry = static_cast<int>(fuzzyEntries.size());
+    fuzzyEntries.push_back({ letterMask(folded), static_cast<int>(folded.size()), nameID, token, names });
+    if (entriesByLength.size() <= folded.size()) entriesByLength.resize(folded.size() + 1);
+    entriesByLength[folded.size()].push_back(entry);
+
+    std::vector<uint32_t> grams;
+    paddedTrigrams(folded, grams);
+    for (uint32_t gram : grams) {
+        int slot = fuzzyGramSlots.find(gram);
+        if (slot < 0) {
+            slot = static_cast<int>(fuzzyGramEntries.size());
+            fuzzyGramEntries.emplace_back();
+            fuzzyGramSlots.insert(gram, slot);
+        }
+        fuzzyGramEntries[slot].push_back(entry);
+    }
+}
+
+// Add a newly interned name to the token and trigram indexes
+void PlayerNameIndex::indexName(int nameID) {
+    const std::string& folded = foldedNames[nameID];
+
+    // Word tokens (first name, surname, ...)
+    size_t start = 0;
+    while (start < folded.size()) {
+        size_t end = folded.find(' ', start);
+        if (end == std::string::npos) end = folded.size();
+        if (end > start) {
+            auto entry = tokenNames.try_emplace(folded.substr(start, end - start));
+            if (entry.second) {
+                addFuzzyEntry(entry.first->first, -1, &entry.first->first, &entry.first->second);
+            }
+            std::vector<int>& ids = entry.first->second;
+            if (ids.empty() || ids.back() != nameID) ids.push_back(nameID);
+        }
+        start = end + 1;
+    }
+
+    // Trigrams over the whole folded name
+    for (size_t i = 0; i + 3 <= folded.size(); i++) {
+        uint32_t trigram = packTrigram(folded, i);
+        int slot = trigramSlots.find(trigram);
+        if (slot < 0) {
+            slot = static_cast<int>(trigramNames.size());
+            trigramNames.emplace_back();
+            trigramSlots.insert(trigram, slot);
+        }
+        std::vector<int>& ids = trigramNames[slot];
+        if (ids.empty() || ids.back() != nameID) ids.push_back(nameID);
+    }
+}
+
+// ID for a name, interning it if it has not been seen yet
+int PlayerNameIndex::intern(const std::string& name) {
+    std::string folded = fold(name);
+    auto it = nameIDs.find(folded);
+    if (it != nameIDs.end()) {
+        return it->second;
+    }
+
+    int nameID = static_cast<int>(foldedNames.size());
+    nameIDs.emplace(folded, nameID);
+    foldedNames.push_back(std::move(folded));
+    displayNames.push_back(name);
+    postings.emplace_back();
+    addFuzzyEntry(foldedNames[nameID], nameID, nullptr, nullptr);
+    indexName(nameID);
+    return nameID;
+}
+
+// ID of a name (case-insensitive exact match), or -1
+int PlayerNameIndex::findName(const std::string& name) const {
+    auto it = nameIDs.find(fold(name));
+    return it == nameIDs.end() ? -1 : it->second;
+}
+
+// IDs of names containing the given word token
+const std::vector<int>* PlayerNameIndex::findToken(const std::string& token) const {
+    auto it = tokenNames.find(fold(token));
+    return it == tokenNames.end() ? nullptr : &it->second;
+}
+
+// IDs of names containing the query as a substring (case-insensitive)
+void PlayerNameIndex::findNamesContaining(const std::string& query, std::vector<int>& ids) const {
+    ids.clear();
+    std::string folded = fold(query);
+    if (folded.empty()) return;
+
+    if (folded.size() < 3) {
+        // Too short for trigrams: check every distinct name
+        for (int i = 0; i < static_cast<int>(foldedNames.size()); i++) {
+            if (foldedNames[i].find(folded) != std::string::npos) ids.push_back(i);
+        }
+        return;
+    }
+
+    // Candidates come from the rarest trigram of the query; each one is then
+    // confirmed against the full name
+    const std::vector<int>* rarest = nullptr;
+    for (size_t i = 0; i + 3 <= folded.size(); i++) {
+        int slot = trigramSlots.find(packTrigram(folded, i));
+        if (slot < 0) return; // Some trigram never occurs, so nothing can match
+        if (rarest == nullptr || trigramNames[slot].size() < rarest->size()) {
+            rarest = &trigramNames[slot];
+        }
+    }
+
+    for (int nameID : *rarest) {
+        if (foldedNames[nameID].find(folded) != std::string::npos) ids.push_back(nameID);
+    }
+}
+
+// Names within maxDistance edits of the query, closest first
+void PlayerNameIndex::findSimilarNames(const std::string& query, int maxDistance, std::vector<NameCandidate>& found) const {
+    found.clear();
+    std::string folded = fold(query);
+    FuzzyPattern pattern(folded);
+    if (pattern.getLength() == 0) return;
+
+    uint32_t letters = letterMask(folded);
+    auto mayBeClose = [&](uint32_t other) {
+        return std::popcount(letters & ~other) <= maxDistance && std::popcount(other & ~letters) <= maxDistance;
+    };
+
+    // Compare one whole name or word; a word stands for every name sharing it
+    auto compare = [&](int entry) {
+        const FuzzyEntry& fuzzy = fuzzyEntries[entry];
+        if (std::abs(fuzzy.length - pattern.getLength()) > maxDistance || !mayBeClose(fuzzy.letters)) return;
+        if (fuzzy.token == nullptr) {
+            if (postings[fuzzy.nameID].empty()) return;
+            int distance = pattern.distance(foldedNames[fuzzy.nameID], maxDistance);
+            if (distance <= maxDistance) found.push_back({ fuzzy.nameID, distance });
+            return;
+        }
+        int distance = pattern.distance(*fuzzy.token, maxDistance);
+        if (distance > maxDistance) return;
+        for (int nameID : *fuzzy.names) {
+            if (!postings[nameID].empty()) found.push_back({ nameID, distance });
+        }
+    };
+
+    // An entry within maxDistance edits shares at least this many of the
+    // query's padded trigrams
+    std::vector<uint32_t> grams;
+    paddedTrigrams(folded, grams);
+    int minShared = static_cast<int>(grams.size()) - 3 * maxDistance;
+
+    if (minShared <= 0) {
+        // The query is too short to rule anything out by trigrams: scan the
+        // lengths within maxDistance of it
+        size_t minLength = folded.size() > static_cast<size_t>(maxDistance) ? folded.size() - maxDistance : 0;
+        size_t maxLength = folded.size() + maxDistance;
+        for (size_t length = minLength; length <= maxLength && length < entriesByLength.size(); length++) {
+            for (int entry : entriesByLength[length]) compare(entry);
+        }
+    } else {
+        // An entry missing from more than 3 * maxDistance of the query's
+        // trigram lists cannot be close, so every close entry appears in at
+        // least one of the rarest 3 * maxDistance + 1 lists. Only those are
+        // read; each entry in them is compared once.
+        std::vector<const std::vector<int>*> lists;
+        for (uint32_t gram : grams) {
+            int slot = fuzzyGramSlots.find(gram);
+            if (slot >= 0) lists.push_back(&fuzzyGramEntries[slot]);
+        }
+        int readLists = static_cast<int>(lists.size()) - minShared + 1;
+        if (readLists > 0) {
+            std::partial_sort(lists.begin(), lists.begin() + readLists, lists.end(),
+                              [](const std::vector<int>* a, const std::vector<int>* b) { return a->size() < b->size(); });
+            fuzzyGramSeen.resize(fuzzyEntries.size());
+            std::vector<int> touched;
+            for (int i = 0; i < readLists; i++) {
+                for (int entry : *lists[i]) {
+                    if (fuzzyGramSeen[entry]) continue;
+                    fuzzyGramSeen[entry] = 1;
+                    touched.push_back(entry);
+                    compare(entry);
+                }
+            }
+            for (int entry : touched) fuzzyGramSeen[entry] = 0;
+        }
+    }
+
+    // Keep each name once, at its smallest distance
+    std::sort(found.begin(), found.end(), [](const NameCandidate& a, const NameCandidate& b) {
+        return a.nameID != b.nameID ? a.nameID < b.nameID : a.distance < b.distance;
+    });
+    found.erase(std::unique(found.begin(), found.end(), [](const NameCandidate& a, const NameCandidate& b) {
+        return a.nameID == b.nameID;
+    }), found.end());
+
+    std::sort(found.begin(), found.end(), [this](const NameCandidate& a, const NameCandidate& b) {
+        if (a.distance != b.distance) return a.distance < b.distance;
+        if (postings[a.nameID].size() != postings[b.nameID].size()) {
+            return postings[a.nameID].size() > postings[b.nameID].size();
+        }
+        return a.nameID < b.nameID;
+    });
+}
+
+void PlayerNameIndex::addPosting(int nameID, int position) {
+    std::vector<int>& list = postings[nameID];
+    if (list.empty() || list.back() < position) {
+        list.push_back(position); // Common case: a new match on top of the stack
+        return;
+    }
+    auto it = std::lower_bound(list.begin(), list.end(), position);
+    if (it == list.end() || *it != position) list.insert(it, position);
+}
+
+void PlayerNameIndex::removePosting(int nameID, int position) {
+    std::vector<int>& list = postings[nameID];
+    auto it = std::lower_bound(list.begin(), list.end(), position);
+    if (it != list.end() && *it == position) list.erase(it);
+}
+
+// Record that the match stored at position involves its two players
+void PlayerNameIndex::addMatch(int position, const Match& match) {
+    addPosting(intern(match.player1), position);
+    addPosting(intern(match.player2), position);
+}
+
+// Record a match between two interned players
+void PlayerNameIndex::addMatch(int position, int player1ID, int player2ID) {
+    addPosting(player1ID, position);
+    addPosting(player2ID, position);
+}
+
+// Make room for count more matches of an interned player
+void PlayerNameIndex::reservePostings(int nameID, int count) {
+    postings[nameID].reserve(postings[nameID].size() + count);
+}
+
+// Forget the match previously recorded at position
+void PlayerNameIndex::removeMatch(int position, const Match& match) {
+    int id1 = findName(match.player1);
+    int id2 = findName(match.player2);
+    if (id1 >= 0) removePosting(id1, position);
+    if (id2 >= 0 && id2 != id1) removePosting(id2, position);
+}
+
+// Stack positions of all matches involving a matching player, most recent first
+void PlayerNameIndex::findMatches(const std::string& query, std::vector<int>& positions) const {
+    positions.clear();
+
+    std::vector<int> ids;
+    findNamesContaining(query, ids);
+
+    if (ids.size() == 1) {
+        // A single posting list is already ordered; just reverse it
+        positions.assign(postings[ids[0]].rbegin(), postings[ids[0]].rend());
+        return;
+    }
+
+    for (int nameID : ids) {
+        positions.insert(positions.end(), postings[nameID].begin(), postings[nameID].end());
+    }
+
+    // A match can be reached through both of its players
+    std::sort(positions.begin(), positions.end(), [](int a, int b) { return a > b; });
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+}
+
+// Stack positions of one player's matches (ascending)
+const std::vector<int>& PlayerNameIndex::getPostings(int nameID) const {
+    return postings[nameID];
+}
+
+// Name as it first appeared in the history
+const std::string& PlayerNameIndex::getName(int nameID) const {
+    return displayNames[nameID];
+}
+
+// Number of distinct names interned
+int PlayerNameIndex::getNameCount() const {
+    return static_cast<int>(foldedNames.size());
+}
+
+// Remove all names and postings
+void PlayerNameIndex::clear() {
+    nameIDs.clear();
+    foldedNames.clear();
+    displayNames.clear();
+    postings.clear();
+    tokenNames.clear();
+    trigramSlots.clear();
+    trigramNames.clear();
+    fuzzyEntries.clear();
+    entriesByLength.clear();
+    fuzzyGramSlots.clear();
+    fuzzyGramEntries.clear();
+}
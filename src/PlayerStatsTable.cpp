@@ -0,0 +1,154 @@
+// PlayerStatsTable.cpp
+#include "../include/PlayerStatsTable.h"
+
+namespace {
+
+// Append one decided result to a player's streak and form
+void pushResult(PlayerStats& stats, bool won) {
+    if (won) {
+        stats.currentStreak = stats.currentStreak > 0 ? stats.currentStreak + 1 : 1;
+        if (stats.currentStreak > stats.longestWinStreak) stats.longestWinStreak = stats.currentStreak;
+    } else {
+        stats.currentStreak = stats.currentStreak < 0 ? stats.currentStreak - 1 : -1;
+    }
+    stats.form = ((stats.form << 1) | (won ? 1u : 0u)) & ((1u << PlayerStatsTable::FORM_LENGTH) - 1);
+    if (stats.formLength < PlayerStatsTable::FORM_LENGTH) stats.formLength++;
+}
+
+}
+
+// Constructor
+PlayerStats::PlayerStats()
+    : wins(0), losses(0), setsWon(0), setsLost(0), gamesWon(0), gamesLost(0),
+      currentStreak(0), longestWinStreak(0), form(0), formLength(0) {}
+
+// Constructor
+PlayerStatsTable::PlayerStatsTable() : staleCount(0), changedAll(true) {}
+
+PlayerStats& PlayerStatsTable::entry(int nameID) {
+    if (nameID >= static_cast<int>(table.size())) {
+        table.resize(nameID + 1);
+        stale.resize(nameID + 1, 0);
+    }
+    return table[nameID];
+}
+
+// Note a change to a player for takeChanges
+void PlayerStatsTable::noteChange(int nameID, bool mayDecrease) {
+    if (changedAll) {
+        return;
+    }
+    // Past one entry per player a full rescan is cheaper than the list
+    if (mayDecrease || changed.size() >= table.size()) {
+        changedAll = true;
+        changed.clear();
+        return;
+    }
+    changed.push_back(nameID);
+}
+
+void PlayerStatsTable::markStale(int nameID) {
+    if (!stale[nameID]) {
+        stale[nameID] = 1;
+        staleCount++;
+    }
+}
+
+// Add (sign = 1) or subtract (sign = -1) one side of a match
+void PlayerStatsTable::applyMatch(int nameID, int side, int winnerSide, MatchScore score, int sign, bool latest) {
+    PlayerStats& stats = entry(nameID);
+    noteChange(nameID, sign < 0);
+    int other = side == 1 ? 2 : 1;
+    stats.setsWon += sign * score.getSetsWon(side);
+    stats.setsLost += sign * score.getSetsWon(other);
+    stats.gamesWon += sign * score.getGamesWon(side);
+    stats.gamesLost += sign * score.getGamesWon(other);
+
+    if (winnerSide == 0) {
+        return; // Undecided: no effect on results, streak or form
+    }
+    bool won = winnerSide == side;
+    (won ? stats.wins : stats.losses) += sign;
+
+    if (sign < 0 || !latest) {
+        markStale(nameID);
+        return;
+    }
+    if (stale[nameID]) {
+        return; // Rebuilt in full when next read
+    }
+
+    pushResult(stats, won);
+}
+
+// Record a match for both players
+void PlayerStatsTable::recordMatch(int player1ID, int player2ID, int winnerSide, MatchScore score, bool latest) {
+    applyMatch(player1ID, 1, winnerSide, score, 1, latest);
+    applyMatch(player2ID, 2, winnerSide, score, 1, latest);
+}
+
+// Take back a match recorded earlier
+void PlayerStatsTable::unrecordMatch(int player1ID, int player2ID, int winnerSide, MatchScore score) {
+    applyMatch(player1ID, 1, winnerSide, score, -1, false);
+    applyMatch(player2ID, 2, winnerSide, score, -1, false);
+}
+
+// Check whether a player's streak and form must be rebuilt before use
+bool PlayerStatsTable::isStale(int nameID) const {
+    return nameID >= 0 && nameID < static_cast<int>(stale.size()) && stale[nameID];
+}
+
+// Check whether any player's streak and form must be rebuilt
+bool PlayerStatsTable::hasStale() const {
+    return staleCount > 0;
+}
+
+// Rebuild a player's streak and form from their results, oldest first
+void PlayerStatsTable::rebuildStreaks(int nameID, const std::vector<int>& results) {
+    PlayerStats& stats = entry(nameID);
+    noteChange(nameID, true);
+    stats.currentStreak = 0;
+    stats.longestWinStreak = 0;
+    stats.form = 0;
+    stats.formLength = 0;
+
+    for (int result : results) {
+        if (result == 0) continue;
+        pushResult(stats, result > 0);
+    }
+    if (stale[nameID]) {
+        stale[nameID] = 0;
+        staleCount--;
+    }
+}
+
+// Statistics of a player, or nullptr if they have no matches recorded
+const PlayerStats* PlayerStatsTable::find(int nameID) const {
+    if (nameID < 0 || nameID >= static_cast<int>(table.size())) {
+        return nullptr;
+    }
+    return &table[nameID];
+}
+
+// Move the name IDs changed since the last call into nameIDs
+bool PlayerStatsTable::takeChanges(std::vector<int>& nameIDs) {
+    nameIDs.clear();
+    nameIDs.swap(changed);  // Both buffers keep their capacity
+    bool listed = !changedAll;
+    changedAll = false;
+    return listed;
+}
+
+// Number of name IDs with a table entry
+int PlayerStatsTable::getSize() const {
+    return static_cast<int>(table.size());
+}
+
+// Forget every player
+void PlayerStatsTable::clear() {
+    table.clear();
+    stale.clear();
+    staleCount = 0;
+    changed.clear();
+    changedAll = true;
+}
@@ -1,5 +1,64 @@
 // PlayerWithdrawalManager.cpp
 #include "../include/PlayerWithdrawalManager.h"
+#include "../include/MappedFile.h"
+#include "../include/ParallelLineParser.h"
+#include "../include/FuzzyMatch.h"
+#include <vector>
+#include <cctype>
+
+namespace {
+
+// Reads comma-separated fields from one line with the same results as
+// getline(ss >> std::ws, field, ',') on a stringstream, without the stream
+class LineFields {
+private:
+    std::string_view rest;
+    bool done;  // Once the stream would hit EOF, every later read is empty
+
+public:
+    explicit LineFields(std::string_view line) : rest(line), done(false) {}
+
+    // Equivalent of `ss >> std::ws`
+    LineFields& skipSpace() {
+        if (done) return *this;
+        size_t i = 0;
+        while (i < rest.size() && std::isspace(static_cast<unsigned char>(rest[i]))) i++;
+        rest.remove_prefix(i);
+        if (rest.empty()) done = true;
+        return *this;
+    }
+
+    // Equivalent of getline(ss, field, ',')
+    std::string field() {
+        if (done || rest.empty()) {
+            done = true;
+            return "";
+        }
+        size_t comma = rest.find(',');
+        std::string value(rest.substr(0, comma));
+        if (comma == std::string_view::npos) {
+            rest = std::string_view();
+            done = true;
+        } else {
+            rest.remove_prefix(comma + 1);
+        }
+        return value;
+    }
+
+    // Equivalent of getline(ss, field)
+    std::string remainder() {
+        if (done || rest.empty()) {
+            done = true;
+            return "";
+        }
+        std::string value(rest);
+        rest = std::string_view();
+        done = true;
+        return value;
+    }
+};
+
+}
 
 // ===================== Queue Method Definitions =====================
 
@@ -150,27 +209,36 @@ TournamentSystem::~TournamentSystem() {
 }
 
 void TournamentSystem::loadSchedule() {
-    std::ifstream file("data/schedule.txt");
-    if (!file) {
+    MappedFile file;
+    if (!file.open("data/schedule.txt")) {
         std::cerr << "Error: Unable to open schedule.txt\n";
         return;
     }
-    std::string line;
-    getline(file, line);
-    while (getline(file, line)) {
-        std::stringstream ss(line);
-        std::string matchID, round, player1, player2, date, status;
-        getline(ss, matchID, ',');
-        getline(ss >> std::ws, round, ',');
-        getline(ss >> std::ws, player1, ',');
-        getline(ss >> std::ws, player2, ',');
-        getline(ss >> std::ws, date, ',');
-        getline(ss >> std::ws, status);
-        Match* newMatch = new Match(matchID, round, player1, player2, date, status);
-        newMatch->next = matchHead;
-        matchHead = newMatch;
+    std::string_view text = file.view();
+    takeLine(text); // Skip header
+
+    // Build the nodes for each chunk of lines in parallel
+    std::vector<std::vector<Match*>> chunks = parseInParallel<std::vector<Match*>>(
+        text, chooseParseThreads(text.size()), [](std::string_view chunk, std::vector<Match*>& nodes) {
+            while (!chunk.empty()) {
+                LineFields fields(takeLine(chunk));
+                std::string matchID = fields.field();
+                std::string round = fields.skipSpace().field();
+                std::string player1 = fields.skipSpace().field();
+                std::string player2 = fields.skipSpace().field();
+                std::string date = fields.skipSpace().field();
+                std::string status = fields.skipSpace().remainder();
+                nodes.push_back(new Match(matchID, round, player1, player2, date, status));
+            }
+        });
+
+    // Link them in file order, each one in front of the last
+    for (const std::vector<Match*>& nodes : chunks) {
+        for (Match* newMatch : nodes) {
+            newMatch->next = matchHead;
+            matchHead = newMatch;
+        }
     }
-    file.close();
 }
 
 std::string TournamentSystem::extractWithdrawReason(const std::string& statusStr) {
@@ -183,55 +251,49 @@ std::string TournamentSystem::extractWithdrawReason(const std::string& statusStr
 }
 
 void TournamentSystem::loadPlayers() {
-    std::ifstream file("data/player_list.txt");
-    if (!file) {
+    MappedFile file;
+    if (!file.open("data/player_list.txt")) {
         std::cerr << "Error: Unable to open player_list.txt\n";
         return;
     }
-    std::string line;
-    getline(file, line); // Skip header
-    while (getline(file, line)) {
-        std::stringstream ss(line);
-        Player* newPlayer = new Player;
-        getline(ss, newPlayer->id, ',');
-        getline(ss >> std::ws, newPlayer->name, ',');
-        getline(ss >> std::ws, newPlayer->status);
-
-        // Remove potential trailing newline or whitespace
-        newPlayer->status.erase(remove(newPlayer->status.begin(), newPlayer->status.end(), '\r'), newPlayer->status.end());
-        newPlayer->status.erase(remove(newPlayer->status.begin(), newPlayer->status.end(), '\n'), newPlayer->status.end());
+    std::string_view text = file.view();
+    takeLine(text); // Skip header
+
+    // Build the nodes for each chunk of lines in parallel
+    std::vector<std::vector<Player*>> chunks = parseInParallel<std::vector<Player*>>(
+        text, chooseParseThreads(text.size()), [this](std::string_view chunk, std::vector<Player*>& nodes) {
+            while (!chunk.empty()) {
+                LineFields fields(takeLine(chunk));
+                Player* newPlayer = new Player;
+                newPlayer->id = fields.field();
+                newPlayer->name = fields.skipSpace().field();
+                newPlayer->status = fields.skipSpace().remainder();
+
+                // Remove potential trailing newline or whitespace
+                newPlayer->status.erase(remove(newPlayer->status.begin(), newPlayer->status.end(), '\r'), newPlayer->status.end());
+                newPlayer->status.erase(remove(newPlayer->status.begin(), newPlayer->status.end(), '\n'), newPlayer->status.end());
+
+                // Extract withdraw reason if present
+                if (newPlayer->status.find("Withdrawn") != std::string::npos) {
+                    newPlayer->withdrawReason = extractWithdrawReason(newPlayer->status);
+                    newPlayer->status = "Withdrawn";
+                }
+                nodes.push_back(newPlayer);
+            }
+        });
 
-        // Extract withdraw reason if present
-        if (newPlayer->status.find("Withdrawn") != std::string::npos) {
-            newPlayer->withdrawReason = extractWithdrawReason(newPlayer->status);
-            newPlayer->status = "Withdrawn";
+    // Link them in file order, each one in front of the last
+    for (const std::vector<Player*>& nodes : chunks) {
+        for (Player* newPlayer : nodes) {
+            newPlayer->next = playerHead;
+            playerHead = newPlayer;
         }
-
-        newPlayer->next = playerHead;
-        playerHead = newPlayer;
     }
-    file.close();
 }
 
 int TournamentSystem::levenshteinDistance(const std::string& a, const std::string& b) {
-    int lenA = a.length();
-    int lenB = b.length();
-    int dp[101][101] = {};
-
-    for (int i = 0; i <= lenA; ++i) dp[i][0] = i;
-    for (int j = 0; j <= lenB; ++j) dp[0][j] = j;
-
-    for (int i = 1; i <= lenA; ++i) {
-        for (int j = 1; j <= lenB; ++j) {
-            if (tolower(a[i - 1]) == tolower(b[j - 1])) {
-                dp[i][j] = dp[i - 1][j - 1];
-            }
-            else {
-                dp[i][j] = 1 + std::min(std::min(dp[i - 1][j], dp[i][j - 1]), dp[i - 1][j - 1]);
-            }
-        }
-    }
-    return dp[lenA][lenB];
+    // Shared bit-parallel implementation; no limit on name length
+    return editDistance(a, b);
 }
 
 void TournamentSystem::searchPlayer() {
@@ -338,10 +400,11 @@ void TournamentSystem::searchPlayerByName(const std::string& query, TournamentSy
         std::cout << "| No. | Player Name       | ID    | Status         |\n";
         std::cout << "--------------------------------------------------\n";
 
+        FuzzyPattern pattern(query); // Case-insensitive, prepared once for every name
         current = playerHead;
         while (current) {
-            std::string firstName = current->name.substr(0, current->name.find(" "));
-            int dist = levenshteinDistance(toLower(query), toLower(firstName));
+            std::string_view firstName = std::string_view(current->name).substr(0, current->name.find(" "));
+            int dist = pattern.distance(firstName, 2);
 
             if (dist <= 2) {
                 std::cout << "| " << std::setw(3) << ++count << " | "
@@ -0,0 +1,109 @@
+// TicketIDAllocator.cpp
+#include "../include/TicketIDAllocator.h"
+#include <fstream>
+#include <charconv>
+#include <cstdio>
+
+// Constructor
+TicketIDAllocator::TicketIDAllocator(const std::string& markPath) : lastNumber(0), reservedUpTo(0), markPath(markPath) {}
+
+// Destructor (gives back unused reserved numbers)
+TicketIDAllocator::~TicketIDAllocator() {
+    release();
+}
+
+// Read the persisted high-water mark, if any
+void TicketIDAllocator::load() {
+    std::ifstream file(markPath);
+    long long number;
+    if (file >> number) {
+        seed(number);
+        reservedUpTo = number;
+    }
+}
+
+// Replace the mark file with value (temporary file, then rename)
+bool TicketIDAllocator::writeMark(long long value) const {
+    const std::string tempPath = markPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        file << value << '\n';
+        if (!file.flush()) {
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(markPath.c_str());
+#endif
+    return std::rename(tempPath.c_str(), markPath.c_str()) == 0;
+}
+
+// Make sure later numbers are above number (safe to call concurrently)
+void TicketIDAllocator::seed(long long number) {
+    long long current = lastNumber.load();
+    while (current < number && !lastNumber.compare_exchange_weak(current, number)) {
+    }
+}
+
+// Issue the next number (safe to call concurrently)
+bool TicketIDAllocator::allocate(long long& number) {
+    number = lastNumber.fetch_add(1) + 1;
+    if (number <= reservedUpTo.load()) {
+        return true;
+    }
+
+    // The block ran out: one caller reserves the next one while the others
+    // past it wait, so no number is handed out before it is on disk
+    std::lock_guard<std::mutex> lock(markMutex);
+    if (number <= reservedUpTo.load()) {
+        return true;
+    }
+    long long ceiling = number + BLOCK_SIZE - 1;
+    if (!writeMark(ceiling)) {
+        return false;
+    }
+    reservedUpTo = ceiling;
+    return true;
+}
+
+// Highest number issued or seen so far
+long long TicketIDAllocator::getLastNumber() const {
+    return lastNumber.load();
+}
+
+// Persist the last issued number so unused reserved numbers are not skipped next time
+bool TicketIDAllocator::release() {
+    std::lock_guard<std::mutex> lock(markMutex);
+    long long last = lastNumber.load();
+    if (reservedUpTo.load() <= last) {
+        return true; // Nothing reserved beyond what was issued
+    }
+    if (!writeMark(last)) {
+        return false;
+    }
+    reservedUpTo = last;
+    return true;
+}
+
+// Numeric part of a ticket ID, or -1 if it is not "T" followed by digits
+long long TicketIDAllocator::parseNumber(std::string_view ticketID) {
+    if (ticketID.size() < 2 || ticketID[0] != 'T') {
+        return -1;
+    }
+    long long number;
+    const char* end = ticketID.data() + ticketID.size();
+    auto result = std::from_chars(ticketID.data() + 1, end, number);
+    if (result.ec != std::errc() || result.ptr != end || number < 0) {
+        return -1;
+    }
+    return number;
+}
+
+// Ticket ID for a number
+std::string TicketIDAllocator::format(long long number) {
+    std::string digits = std::to_string(number);
+    if (digits.size() < 3) {
+        digits.insert(0, 3 - digits.size(), '0');
+    }
+    return "T" + digits;
+}
@@ -0,0 +1,112 @@
+// TicketJournal.cpp
+#include "../include/TicketJournal.h"
+#include "../include/MatchJournal.h"
+#include "../include/MappedFile.h"
+#include <algorithm>
+
+// Constructor
+TicketJournal::TicketJournal() : file(nullptr), recordCount(0) {}
+
+// Destructor
+TicketJournal::~TicketJournal() {
+    close();
+}
+
+// Journal file used for a given ticket file
+std::string TicketJournal::journalPathFor(const std::string& basePath) {
+    return basePath + ".journal";
+}
+
+// Open (or create) the journal for basePath
+bool TicketJournal::open(const std::string& basePath) {
+    close();
+
+    // Count the records already present so compaction thresholds carry over
+    int existingRecords = 0;
+    MappedFile existing;
+    if (existing.open(journalPathFor(basePath))) {
+        std::string_view text = existing.view();
+        existingRecords = static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+    }
+
+    file = std::fopen(journalPathFor(basePath).c_str(), "ab");
+    if (file == nullptr) {
+        return false;
+    }
+    journalPath = journalPathFor(basePath);
+    recordCount = existingRecords;
+    return true;
+}
+
+// Close the journal
+void TicketJournal::close() {
+    if (file != nullptr) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    recordCount = 0;
+}
+
+// Check whether the journal is open
+bool TicketJournal::isOpen() const {
+    return file != nullptr;
+}
+
+// Write records and force them to disk
+bool TicketJournal::write(const std::string& records, int count) {
+    if (file == nullptr) {
+        return false;
+    }
+    if (std::fwrite(records.data(), 1, records.size(), file) != records.size() || !syncFile(file)) {
+        return false;
+    }
+    recordCount += count;
+    return true;
+}
+
+// Append a purchase record
+bool TicketJournal::appendPurchase(const Ticket& ticket) {
+    return write("P," + ticket.ticketID + "," + ticket.type + "," + ticket.status + "," + ticket.buyerName + "\n", 1);
+}
+
+// Append a status change record
+bool TicketJournal::appendStatus(const Ticket& ticket) {
+    return write("S," + ticket.ticketID + "," + ticket.status + "\n", 1);
+}
+
+// Append a status change record for each ticket with one write and one sync
+bool TicketJournal::appendStatusBatch(const std::vector<const Ticket*>& tickets) {
+    if (tickets.empty()) {
+        return file != nullptr;
+    }
+    std::string records;
+    for (const Ticket* ticket : tickets) {
+        records += "S,";
+        records += ticket->ticketID;
+        records += ',';
+        records += ticket->status;
+        records += '\n';
+    }
+    return write(records, static_cast<int>(tickets.size()));
+}
+
+// Discard all records once they have been folded into the ticket file
+bool TicketJournal::reset() {
+    if (file == nullptr) {
+        return false;
+    }
+
+    std::FILE* truncated = std::freopen(journalPath.c_str(), "wb", file);
+    if (truncated == nullptr) {
+        file = nullptr;
+        return false;
+    }
+    file = truncated;
+    recordCount = 0;
+    return syncFile(file);
+}
+
+// Number of records in the journal
+int TicketJournal::getRecordCount() const {
+    return recordCount;
+}
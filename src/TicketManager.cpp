@@ -1,51 +1,206 @@
 // TicketManager.cpp
 #include "../include/TicketManager.h"
+#include "../include/MappedFile.h"
+#include "../include/ParallelLineParser.h"
+#include "../include/MatchExporter.h"
+#include "../include/MatchJournal.h"
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cassert>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+
+int chooseTicketQueueCapacity() {
+    if (const char* setting = std::getenv("TCMS_TICKET_QUEUE_CAPACITY")) {
+        int requested = std::atoi(setting);
+        if (requested > 0) return requested;
+    }
+    return 0;
+}
 
-int lastTicketNumber = 0;
+TicketQueue::TicketQueue(int capacity)
+    : capacity(capacity > 0 ? capacity : 0), statusCounts{}, vipPopped(0), regularPopped(0),
+      vipPendingCursor(0), regularPendingCursor(0), journalCompactionThreshold(1000) {}
 
-TicketQueue::TicketQueue() {
-    size = 0;
+Ticket& TicketQueue::at(int index) {
+    return index < vipLane.getSize() ? vipLane.at(index) : regularLane.at(index - vipLane.getSize());
+}
+
+Ticket* TicketQueue::findTicket(const std::string& ticketID) {
+    long long number = TicketIDAllocator::parseNumber(ticketID);
+    if (number < 0) {
+        // Not a "Txxx" ID, so it is not indexed
+        int size = getSize();
+        for (int i = 0; i < size; i++) {
+            if (at(i).ticketID == ticketID) return &at(i);
+        }
+        return nullptr;
+    }
+
+    int slot = idIndex.find(number);
+    if (slot < 0) {
+        return nullptr;
+    }
+    RingQueue<Ticket>& lane = (slot & 1) ? vipLane : regularLane;
+    int index = slot / 2 - ((slot & 1) ? vipPopped : regularPopped);
+    if (index < 0 || index >= lane.getSize() || lane.at(index).ticketID != ticketID) {
+        return nullptr; // Dequeued since it was indexed
+    }
+    return &lane.at(index);
 }
 
-void TicketQueue::enqueue(Ticket newTicket) {
-    if (size >= 100) {
+int* TicketQueue::counterFor(const std::string& status) {
+    if (status == "Pending") return &statusCounts[static_cast<int>(TicketStatus::Pending)];
+    if (status == "Confirmed") return &statusCounts[static_cast<int>(TicketStatus::Confirmed)];
+    return nullptr;
+}
+
+void TicketQueue::setStatus(Ticket& ticket, const std::string& status) {
+    if (int* counter = counterFor(ticket.status)) (*counter)--;
+    ticket.status = status;
+    if (int* counter = counterFor(ticket.status)) (*counter)++;
+}
+
+void TicketQueue::checkStatusCounts() {
+#ifndef NDEBUG
+    int recount[static_cast<int>(TicketStatus::StatusCount)] = {};
+    int size = getSize();
+    for (int i = 0; i < size; i++) {
+        if (int* counter = counterFor(at(i).status)) {
+            recount[counter - statusCounts]++;
+        }
+    }
+    for (int s = 0; s < static_cast<int>(TicketStatus::StatusCount); s++) {
+        assert(recount[s] == statusCounts[s] && "ticket status counter out of step");
+    }
+#endif
+}
+
+int TicketQueue::getSize() const {
+    return vipLane.getSize() + regularLane.getSize();
+}
+
+bool TicketQueue::enqueue(Ticket newTicket) {
+    if (capacity > 0 && getSize() >= capacity) {
         std::cout << "Queue is full!\n";
-        return;
+        return false;
     }
 
     if (newTicket.status == "Cancelled" || newTicket.status == "Rejected" || newTicket.status == "Waiting") {
-        return; // Ignore these tickets
+        return false; // Ignore these tickets
+    }
+
+    if (int* counter = counterFor(newTicket.status)) (*counter)++;
+
+    // VIP tickets go ahead of every Regular ticket
+    long long number = TicketIDAllocator::parseNumber(newTicket.ticketID);
+    if (newTicket.type == "VIP") {
+        if (number >= 0) idIndex.insert(number, (vipPopped + vipLane.getSize()) * 2 + 1);
+        vipLane.push(std::move(newTicket));
+    } else {
+        if (number >= 0) idIndex.insert(number, (regularPopped + regularLane.getSize()) * 2);
+        regularLane.push(std::move(newTicket));
     }
+    return true;
+}
 
-    int pos = size;
-    while (pos > 0 && tickets[pos - 1].type == "Regular" && newTicket.type == "VIP") {
-        tickets[pos] = tickets[pos - 1]; // Shift Regular ticket down to insert VIP
-        pos--;
+bool TicketQueue::dequeue(Ticket& ticket) {
+    if (!vipLane.isEmpty()) {
+        ticket = vipLane.pop();
+        vipPopped++;
+    } else if (!regularLane.isEmpty()) {
+        ticket = regularLane.pop();
+        regularPopped++;
+    } else {
+        return false;
     }
 
-    tickets[pos] = newTicket;
-    size++;
+    if (int* counter = counterFor(ticket.status)) (*counter)--;
+    return true;
+}
+
+bool TicketQueue::addTicket(const Ticket& newTicket) {
+    if (!enqueue(newTicket)) {
+        return false;
+    }
+    afterJournalWrite(journal.appendPurchase(newTicket));
+    return true;
+}
+
+void TicketQueue::admitFromLane(RingQueue<Ticket>& lane, int popped, int& cursor, int count, std::vector<const Ticket*>& admitted) {
+    int index = std::max(cursor - popped, 0);
+    for (; index < lane.getSize() && count > 0; index++) {
+        Ticket& ticket = lane.at(index);
+        if (ticket.status == "Pending") {
+            setStatus(ticket, "Confirmed");
+            admitted.push_back(&ticket);
+            count--;
+        }
+    }
+
+    // Leave the cursor on the next Pending ticket
+    while (index < lane.getSize() && lane.at(index).status != "Pending") {
+        index++;
+    }
+    cursor = popped + index;
+}
+
+void TicketQueue::admitNext(int count, std::vector<const Ticket*>& admitted) {
+    admitted.clear();
+    if (count <= 0 || getStatusCount(TicketStatus::Pending) == 0) {
+        return;
+    }
+
+    // VIP tickets are admitted first, each lane in arrival order
+    admitFromLane(vipLane, vipPopped, vipPendingCursor, count, admitted);
+    admitFromLane(regularLane, regularPopped, regularPendingCursor, count - static_cast<int>(admitted.size()), admitted);
+
+    // One journal write for the whole batch
+    if (!admitted.empty()) {
+        afterJournalWrite(journal.appendStatusBatch(admitted));
+    }
+}
+
+void TicketQueue::admitAll(std::vector<const Ticket*>& admitted) {
+    admitNext(getStatusCount(TicketStatus::Pending), admitted);
+}
+
+bool TicketQueue::admitByID(const std::string& ticketID) {
+    Ticket* ticket = findTicket(ticketID);
+    if (ticket == nullptr) {
+        std::cout << "Ticket " << ticketID << " was not found in the queue.\n";
+        return false;
+    }
+    if (ticket->status != "Pending") {
+        std::cout << "Ticket " << ticketID << " is not pending (" << ticket->status << ").\n";
+        return false;
+    }
+
+    setStatus(*ticket, "Confirmed");
+    std::cout << "[INFO] Ticket Processed: " << ticket->ticketID << " - " << ticket->buyerName << " (Confirmed)\n";
+    afterJournalWrite(journal.appendStatus(*ticket));
+    return true;
 }
 
 void TicketQueue::processTicketEntry() {
-    if (size == 0) {
+    if (getSize() == 0) {
         std::cout << "No valid tickets to process!\n";
         return;
     }
 
-    for (int i = 0; i < size; i++) {
-        if (tickets[i].status == "Pending") {
-            tickets[i].status = "Confirmed";
-            std::cout << "[INFO] Ticket Processed: " << tickets[i].ticketID << " - " << tickets[i].buyerName << " (Confirmed)\n";
-            saveToFile();
-            return;
-        }
+    std::vector<const Ticket*> admitted;
+    admitNext(1, admitted);
+    if (admitted.empty()) {
+        std::cout << "No pending tickets available for processing.\n";
+        return;
     }
-
-    std::cout << "No pending tickets available for processing.\n";
+    std::cout << "[INFO] Ticket Processed: " << admitted[0]->ticketID << " - " << admitted[0]->buyerName << " (Confirmed)\n";
 }
 
 void TicketQueue::displayQueue() {
+    int size = getSize();
     if (size == 0) {
         std::cout << "No tickets in the queue.\n";
         return;
@@ -56,123 +211,214 @@ void TicketQueue::displayQueue() {
     std::cout << std::setw(10) << "TicketID" << std::setw(15) << "Buyer Name" << std::setw(10) << "Type" << std::setw(15) << "Status" << "\n";
     std::cout << "------------------------------------------------------\n";
 
-    bool vipSection = true;
     for (int i = 0; i < size; i++) {
-        if (vipSection && tickets[i].type == "Regular") {
+        if (i == vipLane.getSize()) {
             std::cout << "-------------------- VIP SECTION END ------------------\n";
-            vipSection = false;
         }
 
-        std::cout << std::setw(10) << tickets[i].ticketID << std::setw(15) << tickets[i].buyerName
-                << std::setw(10) << tickets[i].type << std::setw(15) << tickets[i].status << "\n";
+        const Ticket& ticket = at(i);
+        std::cout << std::setw(10) << ticket.ticketID << std::setw(15) << ticket.buyerName
+                << std::setw(10) << ticket.type << std::setw(15) << ticket.status << "\n";
     }
     std::cout << "------------------------------------------------------\n";
 }
 
-void TicketQueue::saveToFile() {
-    std::ofstream file("data/ticket_sales.txt");
-    if (!file) {
-        std::cout << "Error opening file!\n";
-        return;
+void TicketQueue::afterJournalWrite(bool written) {
+    if (!written) {
+        std::cout << "Warning: Could not write to the ticket journal.\n";
+    } else if (journalCompactionThreshold > 0 && journal.getRecordCount() >= journalCompactionThreshold) {
+        saveToFile();
+    }
+}
+
+bool TicketQueue::writeTicketFile(const std::string& path) {
+    BufferedFileWriter file;
+    if (!file.open(path)) {
+        std::cout << "Error: Could not open " << path << " for writing: " << std::strerror(errno) << ".\n";
+        return false;
     }
 
-    // Make a temporary copy of the tickets for sorting
-    Ticket tempTickets[100];
+    checkStatusCounts();
+
+    // Sort pointers to the tickets by ticketID, leaving the queue as it is
+    int size = getSize();
+    std::vector<const Ticket*> sorted;
+    sorted.reserve(size);
     for (int i = 0; i < size; i++) {
-        tempTickets[i] = tickets[i];
+        sorted.push_back(&at(i));
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Ticket* a, const Ticket* b) {
+        return TicketIDAllocator::parseNumber(a->ticketID) < TicketIDAllocator::parseNumber(b->ticketID);
+    });
+
+    file.write("TicketID,BuyerName,Type,Status\n");
+    for (const Ticket* ticket : sorted) {
+        file.write(ticket->ticketID);
+        file.put(',');
+        file.write(ticket->buyerName);
+        file.put(',');
+        file.write(ticket->type);
+        file.put(',');
+        file.write(ticket->status);
+        file.put('\n');
     }
 
-    // Sort the temporary tickets by ticketID using bubble sort
-    for (int i = 0; i < size - 1; i++) {
-        for (int j = 0; j < size - i - 1; j++) {
-            if (tempTickets[j].ticketID > tempTickets[j + 1].ticketID) {
-                // Swap tickets
-                Ticket temp = tempTickets[j];
-                tempTickets[j] = tempTickets[j + 1];
-                tempTickets[j + 1] = temp;
-            }
-        }
+    // The journal is emptied once this file replaces the old one, so it has
+    // to be on disk first
+    errno = 0;
+    if (!file.close(true)) {
+        std::cout << "Error: Could not write " << path << " to disk: " << std::strerror(errno) << ".\n";
+        return false;
     }
+    return true;
+}
 
-    file << "TicketID,BuyerName,Type,Status\n";
-    for (int i = 0; i < size; i++) {
-        file << tempTickets[i].ticketID << "," << tempTickets[i].buyerName << ","
-             << tempTickets[i].type << "," << tempTickets[i].status << "\n";
+// Fold the journal into the ticket file: write and sync the new file beside
+// the old one, swap it in and sync the directory, then empty the journal. If
+// we stop before the journal is emptied, replaying it again is harmless.
+bool TicketQueue::saveToFile() {
+    const std::string tempPath = std::string(TICKET_SALES_FILE) + ".tmp";
+    if (!writeTicketFile(tempPath)) {
+        return false;
+    }
+#ifdef _WIN32
+    std::remove(TICKET_SALES_FILE);
+#endif
+    if (std::rename(tempPath.c_str(), TICKET_SALES_FILE) != 0) {
+        std::cout << "Error: Could not replace " << TICKET_SALES_FILE << ": " << std::strerror(errno) << ".\n";
+        return false;
     }
-    file.close();
-    
+    if (!syncDirectory(TICKET_SALES_FILE)) {
+        std::cout << "Error: Could not sync the directory of " << TICKET_SALES_FILE << ": "
+                  << std::strerror(errno) << "; keeping the journal.\n";
+        return false;
+    }
+    journal.reset();
+
     std::cout << "Ticket data saved to file in ascending order by Ticket ID.\n";
+    return true;
 }
 
-void TicketQueue::loadFromFile() {
-    std::ifstream file("data/ticket_sales.txt");
-    if (!file) {
-        std::cout << "No existing ticket records found.\n";
-        return;
+int TicketQueue::replayJournal() {
+    MappedFile file;
+    if (!file.open(TicketJournal::journalPathFor(TICKET_SALES_FILE))) {
+        return 0; // No journal yet
     }
 
-    std::string line;
-    getline(file, line);
-    while (getline(file, line)) {
-        Ticket t;
+    std::string_view text = file.view();
+    int applied = 0;
+    while (!text.empty()) {
+        std::string_view line = takeLine(text);
         size_t pos1 = line.find(',');
         size_t pos2 = line.find(',', pos1 + 1);
-        size_t pos3 = line.find(',', pos2 + 1);
-
-        if (pos1 == std::string::npos || pos2 == std::string::npos || pos3 == std::string::npos) {
+        if (pos1 != 1 || pos2 == std::string_view::npos) {
             continue; // Skip malformed lines
         }
+        std::string ticketID(line.substr(2, pos2 - 2));
 
-        t.ticketID = line.substr(0, pos1);
-        t.buyerName = line.substr(pos1 + 1, pos2 - pos1 - 1);
-        t.type = line.substr(pos2 + 1, pos3 - pos2 - 1);
-        t.status = line.substr(pos3 + 1);
-
-        enqueue(t);
+        if (line[0] == 'P') {
+            size_t pos3 = line.find(',', pos2 + 1);
+            size_t pos4 = line.find(',', pos3 + 1);
+            if (pos3 == std::string_view::npos || pos4 == std::string_view::npos) {
+                continue;
+            }
+            std::string status(line.substr(pos3 + 1, pos4 - pos3 - 1));
+            idAllocator.seed(TicketIDAllocator::parseNumber(ticketID));
+
+            // The ticket is already on file if we stopped mid-compaction
+            if (Ticket* existing = findTicket(ticketID)) {
+                setStatus(*existing, status);
+            } else {
+                Ticket t;
+                t.ticketID = std::move(ticketID);
+                t.type = line.substr(pos2 + 1, pos3 - pos2 - 1);
+                t.status = std::move(status);
+                t.buyerName = line.substr(pos4 + 1);
+                enqueue(std::move(t));
+            }
+            applied++;
+        } else if (line[0] == 'S') {
+            if (Ticket* existing = findTicket(ticketID)) {
+                setStatus(*existing, std::string(line.substr(pos2 + 1)));
+                applied++;
+            }
+        }
     }
-    file.close();
+    return applied;
 }
 
-int TicketQueue::countTicketsSold() {
-    int count = 0;
-    for (int i = 0; i < size; i++) {
-        if (tickets[i].status == "Pending" || tickets[i].status == "Confirmed") {
-            count++;
-        }
+void TicketQueue::loadFromFile() {
+    idAllocator.load();
+
+    MappedFile file;
+    if (!file.open(TICKET_SALES_FILE)) {
+        std::cout << "No existing ticket records found.\n";
     }
-    return count;
-}
 
-std::string generateTicketID() {
-    std::ifstream file("data/ticket_sales.txt");
-    std::string lastID = "T000";
-    std::string line, tempID;
-
-    if (file) {
-        getline(file, line); // Skip header
-        while (getline(file, line)) {
-            size_t pos = line.find(',');
-            if (pos != std::string::npos) {
-                tempID = line.substr(0, pos);
-                if (tempID > lastID) {
-                    lastID = tempID;
+    std::string_view text = file.view();
+    takeLine(text); // Skip header
+
+    // Parse chunks of lines in parallel, then enqueue in file order
+    std::vector<std::vector<Ticket>> chunks = parseInParallel<std::vector<Ticket>>(
+        text, chooseParseThreads(text.size()), [](std::string_view chunk, std::vector<Ticket>& parsed) {
+            while (!chunk.empty()) {
+                std::string_view line = takeLine(chunk);
+                size_t pos1 = line.find(',');
+                size_t pos2 = line.find(',', pos1 + 1);
+                size_t pos3 = line.find(',', pos2 + 1);
+
+                if (pos1 == std::string_view::npos || pos2 == std::string_view::npos || pos3 == std::string_view::npos) {
+                    continue; // Skip malformed lines
                 }
+
+                Ticket t;
+                t.ticketID = line.substr(0, pos1);
+                t.buyerName = line.substr(pos1 + 1, pos2 - pos1 - 1);
+                t.type = line.substr(pos2 + 1, pos3 - pos2 - 1);
+                t.status = line.substr(pos3 + 1);
+                parsed.push_back(std::move(t));
             }
+        });
+
+    // Later IDs follow the highest one on file, including tickets that
+    // are not queued
+    for (const std::vector<Ticket>& parsed : chunks) {
+        for (const Ticket& t : parsed) {
+            idAllocator.seed(TicketIDAllocator::parseNumber(t.ticketID));
+            enqueue(t);
         }
-        file.close();
     }
 
-    if (lastID.size() > 1 && lastID[0] == 'T') {
-        try {
-            lastTicketNumber = std::stoi(lastID.substr(1));
-        }
-        catch (...) {
-            lastTicketNumber = 0;
-        }
+    // Changes made since the ticket file was last written
+    replayJournal();
+    if (!journal.open(TICKET_SALES_FILE)) {
+        std::cout << "Warning: Could not open the ticket journal.\n";
     }
+    checkStatusCounts();
+}
+
+int TicketQueue::getJournalRecordCount() const {
+    return journal.getRecordCount();
+}
 
-    lastTicketNumber++;
-    return "T" + std::string(3 - std::to_string(lastTicketNumber).length(), '0') + std::to_string(lastTicketNumber);
+void TicketQueue::setJournalCompactionThreshold(int records) {
+    journalCompactionThreshold = records;
+}
+
+int TicketQueue::countTicketsSold() const {
+    return getStatusCount(TicketStatus::Pending) + getStatusCount(TicketStatus::Confirmed);
+}
+
+int TicketQueue::getStatusCount(TicketStatus status) const {
+    return statusCounts[static_cast<int>(status)];
+}
+
+std::string TicketQueue::generateTicketID() {
+    long long number;
+    if (!idAllocator.allocate(number)) {
+        std::cout << "Warning: Could not save the ticket ID counter.\n";
+    }
+    return TicketIDAllocator::format(number);
 }
 
 void purchaseTicket(TicketQueue& ticketQueue) {
@@ -184,7 +430,7 @@ void purchaseTicket(TicketQueue& ticketQueue) {
     }
 
     Ticket newTicket;
-    newTicket.ticketID = generateTicketID();
+    newTicket.ticketID = ticketQueue.generateTicketID();
 
     std::cout << "Enter Buyer Name: ";
     std::cin >> std::ws;
@@ -210,10 +456,76 @@ void purchaseTicket(TicketQueue& ticketQueue) {
     newTicket.type = (choice == 1) ? "VIP" : "Regular";
     newTicket.status = "Pending";
 
-    ticketQueue.enqueue(newTicket);
+    if (!ticketQueue.addTicket(newTicket)) {
+        return;
+    }
     std::cout << "[INFO] Ticket " << newTicket.ticketID << " added for " << newTicket.buyerName << " (" << newTicket.type << ")\n";
+}
+
+void runGateMenu(TicketQueue& ticketQueue) {
+    int choice;
+
+    do {
+        std::cout << "\n------------------------- Process Ticket Entry -------------------------\n";
+        std::cout << "Pending Tickets : " << ticketQueue.getStatusCount(TicketStatus::Pending) << "\n";
+        std::cout << "  1. Admit Next Ticket\n";
+        std::cout << "  2. Admit Next K Tickets\n";
+        std::cout << "  3. Admit All Pending Tickets\n";
+        std::cout << "  4. Admit Ticket by ID\n";
+        std::cout << "  5. Back\n";
+        std::cout << "Enter your choice: ";
+
+        std::cin >> choice;
+        if (std::cin.fail()) {
+            std::cin.clear();
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::cout << "Invalid input! Please enter a number between 1-5.\n";
+            continue;
+        }
+
+        std::vector<const Ticket*> admitted;
+        switch (choice) {
+            case 1:
+                ticketQueue.processTicketEntry();
+                break;
+            case 2: {
+                int count;
+                std::cout << "Enter number of tickets to admit: ";
+                std::cin >> count;
+                if (std::cin.fail() || count <= 0) {
+                    std::cin.clear();
+                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                    std::cout << "Invalid number! Please enter a positive number.\n";
+                    break;
+                }
+                ticketQueue.admitNext(count, admitted);
+                break;
+            }
+            case 3:
+                ticketQueue.admitAll(admitted);
+                break;
+            case 4: {
+                std::string ticketID;
+                std::cout << "Enter Ticket ID: ";
+                std::cin >> ticketID;
+                ticketQueue.admitByID(ticketID);
+                break;
+            }
+            case 5:
+                break;
+            default:
+                std::cout << "Invalid choice! Please enter a number between 1-5.\n";
+        }
 
-    ticketQueue.saveToFile();
+        if ((choice == 2 || choice == 3) && admitted.empty()) {
+            std::cout << "No pending tickets available for processing.\n";
+        } else if (choice == 2 || choice == 3) {
+            for (const Ticket* ticket : admitted) {
+                std::cout << "[INFO] Ticket Processed: " << ticket->ticketID << " - " << ticket->buyerName << " (Confirmed)\n";
+            }
+            std::cout << admitted.size() << " ticket(s) admitted.\n";
+        }
+    } while (choice != 5);
 }
 
 void runTicketManager() {
@@ -247,12 +559,16 @@ void runTicketManager() {
                 purchaseTicket(ticketQueue);
                 break;
             case 2:
-                ticketQueue.processTicketEntry();
+                runGateMenu(ticketQueue);
                 break;
             case 3:
                 ticketQueue.displayQueue();
                 break;
             case 4:
+                // Leave a complete ticket file behind
+                if (ticketQueue.getJournalRecordCount() > 0) {
+                    ticketQueue.saveToFile();
+                }
                 std::cout << "Returning to main menu...\n";
                 break;
             default:
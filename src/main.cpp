@@ -21,7 +21,9 @@ void displayMainMenu() {
 int main() {
     // Initialize components as needed
     MatchHistory matchHistory;
-    // Try to load existing match history
+    // Record each change in a journal next to the history file
+    matchHistory.enableJournal("data/match_history.txt");
+    // Try to load existing match history (base file plus journal)
     matchHistory.loadFromFile("data/match_history.txt");
 
     // For the tournament scheduling component
@@ -30,6 +32,8 @@ int main() {
     int matchCount = 0;
 
     TournamentMatchHistory tournamentHistory; // Changed from MatchHistory to TournamentMatchHistory
+    // Completed tournament matches are passed on to matchHistory
+    TournamentHistorySync historySync(tournamentHistory, matchHistory);
 
     int choice;
     bool running = true;
@@ -47,7 +51,7 @@ int main() {
         switch (choice) {
             case 1:
                 // Tournament Scheduling
-                runMainMenu(scheduledMatches, matchCount, bracket, tournamentHistory); // Updated to use tournamentHistory
+                runMainMenu(scheduledMatches, matchCount, bracket, tournamentHistory, historySync); // Updated to use tournamentHistory
                 break;
 
             case 2:
@@ -95,7 +95,7 @@ Player::Player(int id, std::string name, std::string username, std::string passw
     : id(id), name(name), username(username), password(password), matchesWon(0), matchesLost(0), totalPointsScored(0) {}
 
 int Player::getId() const { return id; }
-std::string Player::getName() const { return name; }
+const std::string& Player::getName() const { return name; }
 std::string Player::getUsername() const { return username; }
 std::string Player::getPassword() const { return password; }
 int Player::getMatchesWon() const { return matchesWon; }
@@ -146,32 +146,56 @@ void TournamentBracket::display() const {
 }
 
 // TournamentMatchHistory Implementation (previously MatchHistory)
-TournamentMatchHistory::TournamentMatchHistory() : completedCount(0) {}
+TournamentMatchHistory::TournamentMatchHistory() {}
 
 void TournamentMatchHistory::addCompletedMatch(TournamentMatch* match) {
-    if (completedCount < 100) completedMatches[completedCount++] = match;
+    completedMatches.push_back(match);
 }
 
 void TournamentMatchHistory::display() const {
     std::cout << "Match History:\n";
-    for (int i = 0; i < completedCount; i++) completedMatches[i]->display();
+    for (const TournamentMatch* match : completedMatches) match->display();
 }
 
 // Convert a TournamentMatch to Match for historical records
+// (each name is copied once, straight into the Match)
 Match convertToHistoricalMatch(const TournamentMatch* tournamentMatch) {
-    std::string player1Name = tournamentMatch->player1->getName();
-    std::string player2Name = tournamentMatch->player2->getName();
-    std::string winnerName = tournamentMatch->winner ? tournamentMatch->winner->getName() : "";
-
     return Match(
         tournamentMatch->id,
-        player1Name,
-        player2Name,
-        winnerName,
+        tournamentMatch->player1->getName(),
+        tournamentMatch->player2->getName(),
+        tournamentMatch->winner ? tournamentMatch->winner->getName() : std::string(),
         tournamentMatch->score
     );
 }
 
+// TournamentHistorySync Implementation
+TournamentHistorySync::TournamentHistorySync(const TournamentMatchHistory& source, MatchHistory& target)
+    : source(source), target(target), highWaterMark(0) {}
+
+int TournamentHistorySync::sync() {
+    int end = static_cast<int>(source.completedMatches.size());
+    if (highWaterMark >= end) return 0;
+
+    std::vector<Match> batch;
+    batch.reserve(end - highWaterMark);
+    int nextID = target.getHighestMatchID() + 1;
+    for (int i = highWaterMark; i < end; i++) {
+        const TournamentMatch* match = source.completedMatches[i];
+        if (match->winner == nullptr) continue;
+        batch.push_back(convertToHistoricalMatch(match));
+        batch.back().matchID = nextID++;
+    }
+    // Matches that fail validation would fail again, so they are not retried
+    highWaterMark = end;
+
+    ImportReport report = target.addMatches(std::move(batch), ConflictPolicy::Skip);
+    if (!report.issues.empty()) displayImportReport(report);
+    return report.added;
+}
+
+int TournamentHistorySync::getHighWaterMark() const { return highWaterMark; }
+
 // Clear screen
 void clearScreen() {
 #ifdef _WIN32
@@ -517,7 +541,7 @@ void generateKnockoutMatches(Player* winners[], int winnerCount, TournamentMatch
 
 
 // Run main menu for tournament scheduling
-void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& bracket, TournamentMatchHistory& history) {
+void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& bracket, TournamentMatchHistory& history, TournamentHistorySync& historySync) {
     Player* players[50];
     int playerCount = 6;
     players[0] = new Player(1, "Low", "p1", "s1");
@@ -535,8 +559,12 @@ void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& b
     int winnerCount = 0;
 
     int choice;
+    int newlyRecorded = 0; // Reported above the next menu, after the screen is cleared
     do {
         clearScreen();
+        if (newlyRecorded > 0) {
+            std::cout << newlyRecorded << " completed matches recorded in match history.\n";
+        }
         displayTournamentMenu();
         std::cin >> choice;
 
@@ -582,6 +610,9 @@ void runMainMenu(TournamentMatch** matches, int matchCount, TournamentBracket& b
                 std::cout << "Invalid choice.\n";
         }
 
+        // Record finished matches while their players and scores still exist
+        newlyRecorded = historySync.sync();
+
     } while (choice != 0);
 
     // Cleanup
@@ -0,0 +1,178 @@
+// VersionedStackTest.cpp
+// One writer keeps pushing to (and rewriting) a VersionedStack while reader
+// threads take snapshots and check that every version they see is complete
+// and that versions only move forward. Pop, push-after-pop and copies are
+// checked against held snapshots first.
+#include "VersionedStack.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+struct Entry {
+    int id = 0;        // Position + 1
+    int revision = 0;  // Times the writer has replaced this entry
+    long long check = 0; // id * 1000003 + revision, so a torn entry shows up
+
+    Entry() {}
+    Entry(int id, int revision) : id(id), revision(revision), check(id * 1000003LL + revision) {}
+};
+
+static std::atomic<int> failures(0);
+
+// Record a failure (only the first few are printed)
+static void fail(const std::string& message) {
+    if (failures.fetch_add(1) < 10) {
+        std::cerr << "FAIL: " << message << std::endl;
+    }
+}
+
+// Check one snapshot on its own; returns false if it is inconsistent
+static bool checkSnapshot(const VersionedStack<Entry>::Snapshot& snapshot) {
+    // The writer publishes once per push, after the first (empty) version
+    if (static_cast<unsigned long long>(snapshot.getSize()) != snapshot.getGeneration() - 1) {
+        fail("size " + std::to_string(snapshot.getSize()) + " does not match generation " +
+             std::to_string(snapshot.getGeneration()));
+        return false;
+    }
+
+    int expected = snapshot.getSize();
+    for (const Entry& entry : snapshot) {
+        if (entry.id != expected || entry.check != entry.id * 1000003LL + entry.revision) {
+            fail("entry at " + std::to_string(expected - 1) + " has ID " + std::to_string(entry.id));
+            return false;
+        }
+        expected--;
+    }
+    return true;
+}
+
+// Popping and pushing again must never change what a held snapshot sees,
+// and a copy must not share anything with its source
+static void checkPopAndCopy() {
+    VersionedStack<Entry> stack;
+    for (int i = 1; i <= 200; i++) {
+        stack.emplace(i, 0);
+    }
+    stack.publish();
+    VersionedStack<Entry>::Snapshot held = stack.snapshot();
+
+    for (int i = 200; i > 100; i--) {
+        if (stack.pop().id != i) fail("pop returned the wrong entry at " + std::to_string(i));
+    }
+    for (int i = 101; i <= 150; i++) {
+        stack.push(Entry(i, 7));
+    }
+    stack.publish();
+
+    if (held.getSize() != 200) {
+        fail("held snapshot changed size after pop and push");
+    }
+    for (int i = 0; i < held.getSize(); i++) {
+        if (held.at(i).id != i + 1 || held.at(i).revision != 0) {
+            fail("held snapshot sees a later push at " + std::to_string(i));
+            break;
+        }
+    }
+
+    VersionedStack<Entry> copy(stack);
+    stack.replace(0, Entry(1, 9));
+    if (copy.getSize() != 150 || copy.at(0).revision != 0 || copy.top().revision != 7 ||
+        copy.snapshot().getSize() != 150) {
+        fail("copy does not match its source");
+    }
+    while (!copy.isEmpty()) copy.pop();
+    if (stack.getSize() != 150 || stack.at(0).revision != 9) {
+        fail("popping a copy changed its source");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    checkPopAndCopy();
+
+    const int pushes = argc > 1 ? std::atoi(argv[1]) : 50000;
+    int readerCount = static_cast<int>(std::thread::hardware_concurrency());
+    if (readerCount < 4) readerCount = 4;
+
+    VersionedStack<Entry> stack;
+    std::atomic<bool> done(false);
+    std::atomic<long long> snapshotsChecked(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < readerCount; r++) {
+        readers.emplace_back([&]() {
+            unsigned long long lastGeneration = 0;
+            int lastSize = 0;
+            VersionedStack<Entry>::Snapshot held;
+            std::vector<int> heldRevisions;
+
+            while (!done.load()) {
+                VersionedStack<Entry>::Snapshot snapshot = stack.snapshot();
+                if (snapshot.getGeneration() < lastGeneration || snapshot.getSize() < lastSize) {
+                    fail("went back from generation " + std::to_string(lastGeneration) + " to " +
+                         std::to_string(snapshot.getGeneration()));
+                }
+                lastGeneration = snapshot.getGeneration();
+                lastSize = snapshot.getSize();
+                checkSnapshot(snapshot);
+                snapshotsChecked++;
+
+                // Hold on to one version and make sure later writes never show through
+                if (heldRevisions.empty() && snapshot.getSize() > 1000) {
+                    held = snapshot;
+                    for (int i = 0; i < held.getSize(); i++) {
+                        heldRevisions.push_back(held.at(i).revision);
+                    }
+                }
+            }
+
+            for (int i = 0; i < static_cast<int>(heldRevisions.size()); i++) {
+                if (held.at(i).revision != heldRevisions[i]) {
+                    fail("held snapshot changed at " + std::to_string(i));
+                    break;
+                }
+            }
+        });
+    }
+
+    // Writer: push one entry per version, rewriting an older entry every so often
+    std::vector<int> revisions;
+    unsigned int seed = 12345;
+    for (int i = 1; i <= pushes; i++) {
+        if (i % 8 == 0) {
+            seed = seed * 1103515245 + 12345;
+            int position = static_cast<int>((seed >> 8) % revisions.size());
+            revisions[position]++;
+            stack.replace(position, Entry(position + 1, revisions[position]));
+        }
+        stack.push(Entry(i, 0));
+        revisions.push_back(0);
+        stack.publish();
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    // The final version must match the writer's own view exactly
+    VersionedStack<Entry>::Snapshot last = stack.snapshot();
+    if (last.getSize() != pushes || !checkSnapshot(last)) {
+        fail("final snapshot has " + std::to_string(last.getSize()) + " entries");
+    }
+    for (int i = 0; i < last.getSize(); i++) {
+        if (last.at(i).revision != revisions[i] || stack.at(i).revision != revisions[i]) {
+            fail("final revision mismatch at " + std::to_string(i));
+            break;
+        }
+    }
+
+    std::cout << readerCount << " readers checked " << snapshotsChecked.load() << " snapshots over "
+              << pushes << " pushes" << std::endl;
+    if (failures.load() > 0) {
+        std::cout << failures.load() << " failures" << std::endl;
+        return 1;
+    }
+    return 0;
+}